@@ -9,6 +9,7 @@
 #include "Population.h"
 #include "LocalSearch.h"
 #include "Individual.h"
+#include "IslandModel.h"
 
 void Genetic::run(int maxIterNonProd, int timeLimit)
 {
@@ -28,23 +29,34 @@ void Genetic::run(int maxIterNonProd, int timeLimit)
 		Individual* offspring = bestOfSREXAndOXCrossovers(population->getNonIdenticalParentsBinaryTournament());
 
 		/* LOCAL SEARCH */
-		// Run the Local Search on the new individual
-		localSearch->run(offspring, params->penaltyCapacity, params->penaltyTimeWarp);
-		// Check if the new individual is the best feasible individual of the population, based on penalizedCost
-		bool isNewBest = population->addIndividual(offspring, true);
-		// In case of infeasibility, repair the individual with a certain probability
-		if (!offspring->isFeasible && params->rng() % 100 < (unsigned int) params->config.repairProbability)
+		// Skip offspring that are clones of individuals in the population: these are local optima already, so the local search would give a clone
+		bool isNewBest = false;
+		if (!params->config.rejectClones || !population->hasClone(offspring))
 		{
-			// Run the Local Search again, but with penalties for infeasibilities multiplied by 10
-			localSearch->run(offspring, params->penaltyCapacity * 10., params->penaltyTimeWarp * 10.);
-			// If the individual is feasible now, check if it is the best feasible individual of the population, based on penalizedCost and add it to the population
-			// If the individual is not feasible now, it is not added to the population
-			if (offspring->isFeasible)
+			// Run the Local Search on the new individual
+			population->runLocalSearch(offspring, params->penaltyCapacity, params->penaltyTimeWarp);
+			// Check if the new individual is the best feasible individual of the population, based on penalizedCost
+			isNewBest = population->addIndividual(offspring, true);
+			// In case of infeasibility, repair the individual with a certain probability
+			if (!offspring->isFeasible && params->rng() % 100 < (unsigned int) params->config.repairProbability)
 			{
-				isNewBest = (population->addIndividual(offspring, false) || isNewBest);
+				// Run the Local Search again, but with penalties for infeasibilities multiplied by 10
+				population->runLocalSearch(offspring, params->penaltyCapacity * 10., params->penaltyTimeWarp * 10.);
+				// If the individual is feasible now, check if it is the best feasible individual of the population, based on penalizedCost and add it to the population
+				// If the individual is not feasible now, it is not added to the population
+				if (offspring->isFeasible)
+				{
+					isNewBest = (population->addIndividual(offspring, false) || isNewBest);
+				}
 			}
 		}
 
+		/* MIGRATION OF ELITE INDIVIDUALS BETWEEN ISLANDS */
+		if (islandModel != nullptr && nbIter > 0 && params->config.migrationInterval > 0 && nbIter % params->config.migrationInterval == 0)
+		{
+			isNewBest = (islandModel->migrate(islandIdx, population) || isNewBest);
+		}
+
 		/* TRACKING THE NUMBER OF ITERATIONS SINCE LAST SOLUTION IMPROVEMENT */
 		if (isNewBest)
 		{
@@ -425,7 +437,8 @@ Individual* Genetic::bestOfSREXAndOXCrossovers(std::pair<const Individual*, cons
 		: offspringSREX;
 }
 
-Genetic::Genetic(Params* params, Split* split, Population* population, LocalSearch* localSearch) : params(params), split(split), population(population), localSearch(localSearch)
+Genetic::Genetic(Params* params, Split* split, Population* population, LocalSearch* localSearch, IslandModel* islandModel, int islandIdx)
+	: params(params), split(split), population(population), localSearch(localSearch), islandModel(islandModel), islandIdx(islandIdx)
 {
 	// After initializing the parameters of the Genetic object, also generate new individuals in the array candidateOffsprings
 	std::generate(candidateOffsprings.begin(), candidateOffsprings.end(), [&]{ return new Individual(params); });
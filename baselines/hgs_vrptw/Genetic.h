@@ -33,6 +33,8 @@ SOFTWARE.*/
 #include "LocalSearch.h"
 #include "Individual.h"
 
+class IslandModel;
+
 // Class to run the genetic algorithm, which incorporates functionality of population management, doing crossovers and updating parameters.
 class Genetic
 {
@@ -40,8 +42,8 @@ public:
 	// Running the genetic algorithm until maxIterNonProd consecutive iterations without improvement or a time limit (in seconds) is reached
 	void run(int maxIterNonProd, int timeLimit);
 
-	// Constructor
-	Genetic(Params* params, Split* split, Population* population, LocalSearch* localSearch);
+	// Constructor (islandModel and islandIdx are only given when the genetic algorithm runs on one of the islands of an IslandModel)
+	Genetic(Params* params, Split* split, Population* population, LocalSearch* localSearch, IslandModel* islandModel = nullptr, int islandIdx = 0);
 
 	// Destructor
 	~Genetic();
@@ -54,6 +56,8 @@ private:
 	Split* split;				// Split algorithm
 	Population* population;		// Population
 	LocalSearch* localSearch;	// Local Search structure
+	IslandModel* islandModel;	// Island model for the migration of individuals (nullptr if there is only one island)
+	int islandIdx;				// Index of the island in the island model
 
 	// Pointers for offspring to edit new offspring in place:
 	// 0 and 1 are reserved for SREX, 2 and 3 are reserved for OX
@@ -3,14 +3,34 @@
 #include <sstream>
 #include <iostream>
 #include <vector>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #include "Individual.h"
 #include "Params.h"
 
+// Hash key of the arc from a to b (the depot is 0), obtained by mixing the two indices with the finalizer of splitmix64.
+// This gives the same result as a table of random keys per arc (Zobrist hashing), without storing a key for each pair of clients
+static uint64_t getArcKey(int a, int b)
+{
+	uint64_t key = (static_cast<uint64_t>(a) << 32) | static_cast<uint64_t>(b);
+	key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+	return key ^ (key >> 31);
+}
+
+// Hash key of the undirected edge between a and b
+static uint64_t getEdgeKey(int a, int b)
+{
+	return getArcKey(std::min(a, b), std::max(a, b));
+}
+
 void Individual::evaluateCompleteCost()
 {
 	// Create an object to store all information regarding solution costs
 	myCostSol = CostSol();
+	edgeHash = 0;
 	// Loop over all routes that are not empty
 	for (int r = 0; r < params->nbVehicles; r++)
 	{
@@ -46,6 +66,7 @@ void Individual::evaluateCompleteCost()
 				time = params->cli[chromR[r][0]].latestArrival;
 			}
 			predecessors[chromR[r][0]] = 0;
+			edgeHash += getEdgeKey(0, chromR[r][0]);
 
 			// Loop over all clients for this vehicle
 			for (int i = 1; i < static_cast<int>(chromR[r].size()); i++)
@@ -72,10 +93,12 @@ void Individual::evaluateCompleteCost()
 				// Update predecessors and successors
 				predecessors[chromR[r][i]] = chromR[r][i - 1];
 				successors[chromR[r][i - 1]] = chromR[r][i];
+				edgeHash += getEdgeKey(chromR[r][i - 1], chromR[r][i]);
 			}
 
 			// For the last client, the successors is the depot. Also update the distance and time
 			successors[chromR[r][chromR[r].size() - 1]] = 0;
+			edgeHash += getEdgeKey(chromR[r][chromR[r].size() - 1], 0);
 			distance += params->timeCost.get(chromR[r][chromR[r].size() - 1], 0);
 			time = time + params->cli[chromR[r][chromR[r].size() - 1]].serviceDuration + params->timeCost.get(chromR[r][chromR[r].size() - 1], 0);
 			
@@ -113,50 +136,84 @@ void Individual::shuffleChromT()
 	std::shuffle(chromT.begin(), chromT.end(), params->rng);
 }
 
-void Individual::removeProximity(Individual* indiv)
+uint64_t Individual::getArcHash() const
 {
-	// Get the first individual in indivsPerProximity
-	auto it = indivsPerProximity.begin();
-	// Loop over all individuals in indivsPerProximity until indiv is found
-	while (it->second != indiv)
+	uint64_t arcHash = 0;
+	for (int j = 1; j <= params->nbClients; j++)
 	{
-		++it;
+		arcHash += getArcKey(j, successors[j]);
+		if (predecessors[j] == 0)
+		{
+			arcHash += getArcKey(0, j);
+		}
 	}
-	// Remove indiv from indivsPerProximity
-	indivsPerProximity.erase(it);
+	return arcHash;
 }
 
 double Individual::brokenPairsDistance(Individual* indiv2)
 {
-	// Initialize the difference to zero. Then loop over all clients of this individual
+	// Count the differences without branches, such that the comparisons are done on several clients at once. For each client j:
+	// - the arc from j to its successor is broken if the successor of j is neither the successor nor the predecessor of j in indiv2
+	// - the arc from the depot to j (which is not covered by the first case) is broken if j is not directly linked to the depot in indiv2
+	const int* succ1 = successors.data();
+	const int* pred1 = predecessors.data();
+	const int* succ2 = indiv2->successors.data();
+	const int* pred2 = indiv2->predecessors.data();
 	int differences = 0;
-	for (int j = 1; j <= params->nbClients; j++)
+	int j = 1;
+#if defined(__AVX2__)
+	// Compare 8 clients at once. The comparison masks are -1 in the lanes where they hold, so subtracting them counts the differences
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i allOnes = _mm256_set1_epi32(-1);
+	__m256i count = zero;
+	for (; j + 8 <= params->nbClients + 1; j += 8)
 	{
-		// Increase the difference if the successor of j in this individual is not directly linked to j in indiv2
-		if (successors[j] != indiv2->successors[j] && successors[j] != indiv2->predecessors[j])
-		{
-			differences++;
-		}
-		// Last loop covers all but the first arc. Increase the difference if the predecessor of j in this individual is not directly linked to j in indiv2
-		if (predecessors[j] == 0 && indiv2->predecessors[j] != 0 && indiv2->successors[j] != 0)
-		{
-			differences++;
-		}
+		__m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(succ1 + j));
+		__m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pred1 + j));
+		__m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(succ2 + j));
+		__m256i p2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pred2 + j));
+		__m256i isArcKept = _mm256_or_si256(_mm256_cmpeq_epi32(s1, s2), _mm256_cmpeq_epi32(s1, p2));
+		__m256i isDepotArcKept = _mm256_or_si256(_mm256_cmpeq_epi32(p2, zero), _mm256_cmpeq_epi32(s2, zero));
+		count = _mm256_sub_epi32(count, _mm256_andnot_si256(isArcKept, allOnes));
+		count = _mm256_sub_epi32(count, _mm256_andnot_si256(isDepotArcKept, _mm256_cmpeq_epi32(p1, zero)));
 	}
-	return static_cast<double>(differences) / params->nbClients;
-}
+	alignas(32) int counts[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(counts), count);
+	for (int lane = 0; lane < 8; lane++)
+	{
+		differences += counts[lane];
+	}
+#elif defined(__SSE2__)
+	// Compare 4 clients at once. The comparison masks are -1 in the lanes where they hold, so subtracting them counts the differences
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i allOnes = _mm_set1_epi32(-1);
+	__m128i count = zero;
+	for (; j + 4 <= params->nbClients + 1; j += 4)
+	{
+		__m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(succ1 + j));
+		__m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pred1 + j));
+		__m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(succ2 + j));
+		__m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pred2 + j));
+		__m128i isArcKept = _mm_or_si128(_mm_cmpeq_epi32(s1, s2), _mm_cmpeq_epi32(s1, p2));
+		__m128i isDepotArcKept = _mm_or_si128(_mm_cmpeq_epi32(p2, zero), _mm_cmpeq_epi32(s2, zero));
+		count = _mm_sub_epi32(count, _mm_andnot_si128(isArcKept, allOnes));
+		count = _mm_sub_epi32(count, _mm_andnot_si128(isDepotArcKept, _mm_cmpeq_epi32(p1, zero)));
+	}
+	alignas(16) int counts[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(counts), count);
+	for (int lane = 0; lane < 4; lane++)
+	{
+		differences += counts[lane];
+	}
+#endif
 
-double Individual::averageBrokenPairsDistanceClosest(int nbClosest)
-{
-	double result = 0;
-	int maxSize = std::min(nbClosest, static_cast<int>(indivsPerProximity.size()));
-	auto it = indivsPerProximity.begin();
-	for (int i = 0; i < maxSize; i++)
+	// Remaining clients (all clients if no SIMD instructions are available)
+	for (; j <= params->nbClients; j++)
 	{
-		result += it->first;
-		++it;
+		differences += (succ1[j] != succ2[j]) & (succ1[j] != pred2[j]);
+		differences += (pred1[j] == 0) & (pred2[j] != 0) & (succ2[j] != 0);
 	}
-	return result / maxSize;
+	return static_cast<double>(differences) / params->nbClients;
 }
 
 void Individual::exportCVRPLibFormat(std::string fileName)
@@ -172,7 +229,7 @@ void Individual::exportCVRPLibFormat(std::string fileName)
 				myfile << "Route #" << k + 1 << ":"; // Route IDs start at 1 in the file format
 				for (int i : chromR[k])
 				{
-					myfile << " " << i;
+					myfile << " " << params->instance->originalIndex[i];	// Clients are written with their index in the instance file
 				}
 				myfile << std::endl;
 			}
@@ -185,21 +242,24 @@ void Individual::exportCVRPLibFormat(std::string fileName)
 
 void Individual::printCVRPLibFormat()
 {
-	std::cout << "----- PRINTING SOLUTION WITH VALUE " << myCostSol.penalizedCost << std::endl;
+	// The solution is written to std::cout at once, such that it is not interleaved with output of other threads
+	std::ostringstream output;
+	output << "----- PRINTING SOLUTION WITH VALUE " << myCostSol.penalizedCost << std::endl;
 	for (int k = 0; k < params->nbVehicles; k++)
 	{
 		if (!chromR[k].empty())
 		{
-			std::cout << "Route #" << k + 1 << ":"; // Route IDs start at 1 in the file format
+			output << "Route #" << k + 1 << ":"; // Route IDs start at 1 in the file format
 			for (int i : chromR[k])
 			{
-				std::cout << " " << i;
+				output << " " << params->instance->originalIndex[i];	// Clients are written with their index in the instance file
 			}
-			std::cout << std::endl;
+			output << std::endl;
 		}
 	}
-	std::cout << "Cost " << (int) myCostSol.penalizedCost << std::endl;
-	std::cout << "Time " << params->getTimeElapsedSeconds() << std::endl;
+	output << "Cost " << (int) myCostSol.penalizedCost << std::endl;
+	output << "Time " << params->getTimeElapsedSeconds() << std::endl;
+	std::cout << output.str() << std::flush;
 	fflush(stdout);
 }
 
@@ -237,7 +297,7 @@ bool Individual::readCVRPLibFormat(std::string fileName, std::vector<std::vector
 	return false;
 }
 
-Individual::Individual(Params* params, bool initializeChromTAndShuffle) : params(params), isFeasible(false), biasedFitness(0)
+Individual::Individual(Params* params, bool initializeChromTAndShuffle) : params(params), proximitySlot(-1), edgeHash(0), isFeasible(false), biasedFitness(0)
 {
 	successors = std::vector<int>(params->nbClients + 1);
 	predecessors = std::vector<int>(params->nbClients + 1);
@@ -249,7 +309,7 @@ Individual::Individual(Params* params, bool initializeChromTAndShuffle) : params
 	}
 }
 
-Individual::Individual(Params* params, std::string solutionStr) : params(params), isFeasible(false), biasedFitness(0)
+Individual::Individual(Params* params, std::string solutionStr) : params(params), proximitySlot(-1), edgeHash(0), isFeasible(false), biasedFitness(0)
 {
 	successors = std::vector<int>(params->nbClients + 1);
 	predecessors = std::vector<int>(params->nbClients + 1);
@@ -271,8 +331,9 @@ Individual::Individual(Params* params, std::string solutionStr) : params(params)
 		}
 		else
 		{
-			chromR[route].push_back(inputCustomer);
-			chromT[pos] = inputCustomer;
+			// Clients are given with their index in the instance file
+			chromR[route].push_back(params->instance->internalIndex[inputCustomer]);
+			chromT[pos] = params->instance->internalIndex[inputCustomer];
 			pos++;
 		}
 	}
@@ -280,7 +341,7 @@ Individual::Individual(Params* params, std::string solutionStr) : params(params)
 	evaluateCompleteCost();
 }
 
-Individual::Individual(): params(nullptr), isFeasible(false), biasedFitness(0)
+Individual::Individual(): params(nullptr), proximitySlot(-1), edgeHash(0), isFeasible(false), biasedFitness(0)
 {
 	myCostSol.penalizedCost = 1.e30;
 }
@@ -24,8 +24,8 @@ SOFTWARE.*/
 #ifndef INDIVIDUAL_H
 #define INDIVIDUAL_H
 
+#include <cstdint>
 #include <vector>
-#include <set>
 #include <string>
 
 #include "Params.h"
@@ -54,7 +54,8 @@ public:
 	std::vector<std::vector<int>> chromR;										// For each vehicle, the associated sequence of deliveries (complete solution). Size is nbVehicles. Routes are stored starting index maxVehicles-1, so the first indices will likely be empty
 	std::vector<int> successors;												// For each node, the successor in the solution (can be the depot 0). Size is nbClients+1
 	std::vector<int> predecessors;												// For each node, the predecessor in the solution (can be the depot 0). Size is nbClients+1
-	std::multiset<std::pair<double, Individual*>> indivsPerProximity;			// The other individuals in the population (can not be the depot 0), ordered by increasing proximity (the set container follows a natural ordering based on the value of the first pair)
+	int proximitySlot;															// Slot of the individual in the proximity structure of its subpopulation (-1 if not in a population)
+	uint64_t edgeHash;															// Hash of the undirected edges of the solution, which is the same for clones (up to hash collisions). Updated by evaluateCompleteCost
 	bool isFeasible;															// Feasibility status of the individual
 	double biasedFitness;														// Biased fitness of the solution
 
@@ -65,15 +66,12 @@ public:
 	// TODO: From line above: "needs to call evaluateCompleteCost afterwards;"
 	void shuffleChromT();
 
-	// Removing the individual indiv from the structure of proximity
-	void removeProximity(Individual* indiv);
+	// Returns a hash of the arcs of the solution, which (unlike edgeHash) depends on the direction of the routes
+	uint64_t getArcHash() const;
 
-	// Distance measure with another individual, based on the number of arcs that differ between two solutions
+	// Distance measure with another individual, based on the number of arcs that differ between two solutions (vectorized with SSE2, or AVX2 if enabled)
 	double brokenPairsDistance(Individual* indiv2);
 
-	// Returns the average distance of this individual with the nbClosest individuals
-	double averageBrokenPairsDistanceClosest(int nbClosest);
-
 	// Exports a solution in CVRPLib format (adds a final line with the computational time)
 	void exportCVRPLibFormat(std::string fileName);
 
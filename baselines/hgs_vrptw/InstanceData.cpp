@@ -0,0 +1,1082 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cmath>
+#include <bit>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "InstanceData.h"
+#include "Matrix.h"
+#include "CircleSector.h"
+
+// Splits a text buffer in tokens (separated by whitespace) and lines, without copying or allocating
+class TextTokenizer
+{
+	std::string_view buffer;		// Text to tokenize
+	size_t position;				// Position of the next character to read
+
+public:
+	// Tells whether c separates two tokens
+	static bool isSeparator(char c)
+	{
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	// Returns the next token, or an empty token at the end of the buffer
+	std::string_view next()
+	{
+		while (position < buffer.size() && isSeparator(buffer[position])) position++;
+		size_t start = position;
+		while (position < buffer.size() && !isSeparator(buffer[position])) position++;
+		return buffer.substr(start, position - start);
+	}
+
+	// Reads the next token as an integer. Returns FALSE (and does not consume the token) if it is not an integer
+	bool tryNextInt(int& value)
+	{
+		size_t start = position;
+		while (start < buffer.size() && isSeparator(buffer[start])) start++;
+		const char* end = buffer.data() + buffer.size();
+		auto [last, error] = std::from_chars(buffer.data() + start, end, value);
+		if (error != std::errc() || (last != end && !isSeparator(*last)))
+		{
+			return false;
+		}
+		position = last - buffer.data();
+		return true;
+	}
+
+	// Reads the next token as an integer, throws an error if it is not an integer
+	int nextInt()
+	{
+		int value;
+		if (!tryNextInt(value))
+		{
+			throw std::string("Expected an integer in instance file instead of: " + std::string(next()));
+		}
+		return value;
+	}
+
+	// Returns the rest of the current line (without the line ending), and moves to the next line
+	std::string_view nextLine()
+	{
+		size_t start = position;
+		size_t end = buffer.find('\n', position);
+		position = (end == std::string_view::npos) ? buffer.size() : end + 1;
+		std::string_view line = buffer.substr(start, std::min(end, buffer.size()) - start);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		return line;
+	}
+
+	TextTokenizer(std::string_view buffer) : buffer(buffer), position(0) {}
+};
+
+InstanceData::InstanceData(const std::string& pathInstance, int nbVeh, bool isReorderClients)
+{
+	nbVehicles = nbVeh;
+	if (isBinaryInstance(pathInstance))
+	{
+		readBinary(pathInstance);
+	}
+	else
+	{
+		// Read the whole file in one buffer
+		std::ifstream inputFile(pathInstance, std::ios::binary | std::ios::ate);
+		if (!inputFile.is_open())
+		{
+			throw std::invalid_argument("Impossible to open instance file: " + pathInstance);
+		}
+		std::string buffer(static_cast<size_t>(inputFile.tellg()), '\0');
+		inputFile.seekg(0);
+		inputFile.read(buffer.data(), buffer.size());
+		readText(buffer);
+	}
+	computeDerivedData();
+	if (isReorderClients)
+	{
+		reorderClients();
+	}
+}
+
+std::shared_ptr<const InstanceData> InstanceData::fromText(std::string_view text, int nbVeh, bool isReorderClients)
+{
+	auto instance = std::make_shared<InstanceData>();
+	instance->nbVehicles = nbVeh;
+	instance->readText(text);
+	instance->computeDerivedData();
+	if (isReorderClients)
+	{
+		instance->reorderClients();
+	}
+	return instance;
+}
+
+void InstanceData::readText(std::string_view buffer)
+{
+	// Same format and checks as readTextStream, but tokenizing a buffer in place (with std::from_chars) instead of using stream extraction
+	TextTokenizer tokens(buffer);
+	int serviceTimeData = 0;
+	bool hasServiceTimeSection = false;
+	nbClients = 0;
+	totalDemand = 0;
+	maxDemand = 0;
+	durationLimit = INT_MAX;
+	vehicleCapacity = INT_MAX;
+	isDurationConstraint = false;
+	isTimeWindowConstraint = false;
+	isExplicitDistanceMatrix = false;
+
+	// Read the instance name from the first line, and skip the next line ("Empty line" or "NAME : {instance_name}")
+	instanceName = std::string(tokens.nextLine());
+	tokens.nextLine();
+
+	// Check if the next line has "VEHICLE"
+	if (tokens.nextLine().substr(0, 7) == "VEHICLE")
+	{
+		// VRPTW format
+		isTimeWindowConstraint = true;
+
+		// Get the number of vehicles and the capacity of the vehicles (after the line NUMBER CAPACITY)
+		tokens.nextLine();
+		nbVehicles = tokens.nextInt();
+		vehicleCapacity = tokens.nextInt();
+
+		// Skip the rest of the line and the next three lines
+		for (int i = 0; i < 4; i++)
+		{
+			tokens.nextLine();
+		}
+
+		// Read the information of all clients
+		cli = std::vector<Client>();
+		cli.reserve(1001);
+		int node;
+		while (tokens.tryNextInt(node))
+		{
+			// Store all the information of the next client
+			Client client = {};
+			client.custNum = node;
+			client.coordX = tokens.nextInt();
+			client.coordY = tokens.nextInt();
+			client.demand = tokens.nextInt();
+			client.earliestArrival = tokens.nextInt();
+			client.latestArrival = tokens.nextInt();
+			client.serviceDuration = tokens.nextInt();
+
+			// Scale coordinates by factor 10, later the distances will be rounded so we optimize with 1 decimal distances
+			client.coordX *= 10;
+			client.coordY *= 10;
+			client.earliestArrival *= 10;
+			client.latestArrival *= 10;
+			client.serviceDuration *= 10;
+			const Client& depot = cli.empty() ? client : cli[0];
+			client.polarAngle = CircleSector::positive_mod(static_cast<int>(32768. * atan2(client.coordY - depot.coordY, client.coordX - depot.coordX) / PI));
+
+			// Keep track of the max demand, the total demand, and the number of clients
+			if (client.demand > maxDemand)
+			{
+				maxDemand = client.demand;
+			}
+			totalDemand += client.demand;
+			cli.push_back(client);
+		}
+		nbClients = static_cast<int>(cli.size());
+
+		// Don't count depot as client
+		nbClients--;
+
+		// Check if the required service and the start of the time window of the depot are both zero
+		if (cli.empty() || cli[0].earliestArrival != 0)
+		{
+			throw std::string("Time window for depot should start at 0");
+		}
+		if (cli[0].serviceDuration != 0)
+		{
+			throw std::string("Service duration for depot should be 0");
+		}
+	}
+	else
+	{
+		// CVRP or VRPTW according to VRPLib format
+		// Checks that the client numbers in a section are in order (1, 2, ...)
+		auto checkClientNr = [&tokens](int i, const char* section)
+		{
+			if (tokens.nextInt() != i + 1)
+			{
+				throw std::string("Clients are not in order in the list of ") + section;
+			}
+		};
+		// Checks that the client data has been allocated (by a section giving DIMENSION before)
+		auto checkDimension = [this]()
+		{
+			if (nbClients <= 0 || static_cast<int>(cli.size()) != nbClients + 1)
+			{
+				throw std::string("DIMENSION should be given before the data of the clients");
+			}
+		};
+
+		for (std::string_view content = tokens.next(); content != "EOF"; content = tokens.next())
+		{
+			if (content.empty())
+			{
+				throw std::string("Unexpected end of instance file (EOF is missing)");
+			}
+			// Read the dimension of the problem (the number of clients)
+			else if (content == "DIMENSION")
+			{
+				// Need to substract the depot from the number of nodes
+				tokens.next();
+				nbClients = tokens.nextInt() - 1;
+				cli = std::vector<Client>(nbClients + 1);
+			}
+			// Read the type of edge weights
+			else if (content == "EDGE_WEIGHT_TYPE")
+			{
+				tokens.next();
+				if (tokens.next() == "EXPLICIT")
+				{
+					isExplicitDistanceMatrix = true;
+				}
+			}
+			else if (content == "EDGE_WEIGHT_FORMAT")
+			{
+				tokens.next();
+				std::string_view format = tokens.next();
+				if (!isExplicitDistanceMatrix)
+				{
+					throw std::string("EDGE_WEIGHT_FORMAT can only be used with EDGE_WEIGHT_TYPE : EXPLICIT");
+				}
+				if (format != "FULL_MATRIX")
+				{
+					throw std::string("EDGE_WEIGHT_FORMAT only supports FULL_MATRIX");
+				}
+			}
+			else if (content == "CAPACITY")
+			{
+				tokens.next();
+				vehicleCapacity = tokens.nextInt();
+			}
+			else if (content == "VEHICLES" || content == "SALESMAN")
+			{
+				// Set vehicle count from instance only if not specified on CLI
+				tokens.next();
+				int nbVehiclesInstance = tokens.nextInt();
+				if (nbVehicles == INT_MAX)
+				{
+					nbVehicles = nbVehiclesInstance;
+				}
+			}
+			else if (content == "DISTANCE")
+			{
+				tokens.next();
+				durationLimit = tokens.nextInt();
+				isDurationConstraint = true;
+			}
+			// Read the data on the service time (used when the service time is constant for all clients)
+			else if (content == "SERVICE_TIME")
+			{
+				tokens.next();
+				serviceTimeData = tokens.nextInt();
+			}
+			// Read the edge weights of an explicit distance matrix
+			else if (content == "EDGE_WEIGHT_SECTION")
+			{
+				if (!isExplicitDistanceMatrix)
+				{
+					throw std::string("EDGE_WEIGHT_SECTION can only be used with EDGE_WEIGHT_TYPE : EXPLICIT");
+				}
+				checkDimension();
+				maxDist = 0;
+				timeCost = Matrix(nbClients + 1);
+				for (int i = 0; i <= nbClients; i++)
+				{
+					for (int j = 0; j <= nbClients; j++)
+					{
+						// Keep track of the largest distance between two clients (or the depot)
+						int cost = tokens.nextInt();
+						if (cost > maxDist)
+						{
+							maxDist = cost;
+						}
+						timeCost.set(i, j, cost);
+					}
+				}
+			}
+			else if (content == "NODE_COORD_SECTION")
+			{
+				// Reading client coordinates
+				checkDimension();
+				for (int i = 0; i <= nbClients; i++)
+				{
+					checkClientNr(i, "coordinates");
+					cli[i].custNum = i;
+					cli[i].coordX = tokens.nextInt();
+					cli[i].coordY = tokens.nextInt();
+					cli[i].polarAngle = CircleSector::positive_mod(static_cast<int>(32768. * atan2(cli[i].coordY - cli[0].coordY, cli[i].coordX - cli[0].coordX) / PI));
+				}
+			}
+			// Read the demand of each client (including the depot, which should have demand 0)
+			else if (content == "DEMAND_SECTION")
+			{
+				checkDimension();
+				for (int i = 0; i <= nbClients; i++)
+				{
+					checkClientNr(i, "demands");
+					cli[i].demand = tokens.nextInt();
+
+					// Keep track of the max and total demand
+					if (cli[i].demand > maxDemand)
+					{
+						maxDemand = cli[i].demand;
+					}
+					totalDemand += cli[i].demand;
+				}
+				// Check if the depot has demand 0
+				if (cli[0].demand != 0)
+				{
+					throw std::string("Depot demand is not zero, but is instead: " + std::to_string(cli[0].demand));
+				}
+			}
+			else if (content == "DEPOT_SECTION")
+			{
+				std::string_view depot = tokens.next();
+				tokens.next();
+				if (depot != "1")
+				{
+					throw std::string("Expected depot index 1 instead of " + std::string(depot));
+				}
+			}
+			else if (content == "SERVICE_TIME_SECTION")
+			{
+				checkDimension();
+				for (int i = 0; i <= nbClients; i++)
+				{
+					checkClientNr(i, "service times");
+					cli[i].serviceDuration = tokens.nextInt();
+				}
+				// Check if the service duration of the depot is 0
+				if (cli[0].serviceDuration != 0)
+				{
+					throw std::string("Service duration for depot should be 0");
+				}
+				hasServiceTimeSection = true;
+			}
+			else if (content == "RELEASE_TIME_SECTION")
+			{
+				checkDimension();
+				for (int i = 0; i <= nbClients; i++)
+				{
+					checkClientNr(i, "release times");
+					cli[i].releaseTime = tokens.nextInt();
+				}
+				// Check if the release time of the depot is 0
+				if (cli[0].releaseTime != 0)
+				{
+					throw std::string("Release time for depot should be 0");
+				}
+			}
+			// Read the time windows of all the clients (the depot should have a time window from 0 to max)
+			else if (content == "TIME_WINDOW_SECTION")
+			{
+				isTimeWindowConstraint = true;
+				checkDimension();
+				for (int i = 0; i <= nbClients; i++)
+				{
+					checkClientNr(i, "time windows");
+					cli[i].earliestArrival = tokens.nextInt();
+					cli[i].latestArrival = tokens.nextInt();
+				}
+
+				// Check the start of the time window of the depot
+				if (cli[0].earliestArrival != 0)
+				{
+					throw std::string("Time window for depot should start at 0");
+				}
+			}
+			else
+			{
+				throw std::string("Unexpected data in input file: " + std::string(content));
+			}
+		}
+
+		if (!hasServiceTimeSection)
+		{
+			for (int i = 0; i <= nbClients; i++)
+			{
+				cli[i].serviceDuration = (i == 0) ? 0 : serviceTimeData;
+			}
+		}
+
+		if (nbClients <= 0)
+		{
+			throw std::string("Number of nodes is undefined");
+		}
+		if (vehicleCapacity == INT_MAX)
+		{
+			throw std::string("Vehicle capacity is undefined");
+		}
+	}
+}
+
+void InstanceData::readTextStream(std::istream& inputFile)
+{
+	// Initialize some parameter values
+	std::string content, content2, content3;
+	int serviceTimeData = 0;
+	int node;
+	bool hasServiceTimeSection = false;
+	nbClients = 0;
+	totalDemand = 0;
+	maxDemand = 0;
+	durationLimit = INT_MAX;
+	vehicleCapacity = INT_MAX;
+	isDurationConstraint = false;
+	isTimeWindowConstraint = false;
+	isExplicitDistanceMatrix = false;
+	
+	// Read INPUT dataset
+	// Read the instance name from the first line and remove \r
+	getline(inputFile, content);
+	instanceName = content;
+	instanceName.erase( std::remove(instanceName.begin(), instanceName.end(), '\r'), instanceName.end());
+
+	// Read the next lines
+	getline(inputFile, content);	// "Empty line" or "NAME : {instance_name}"
+	getline(inputFile, content);	// VEHICLE or "COMMENT: {}"
+
+	// Check if the next line has "VEHICLE"
+	if (content.substr(0, 7) == "VEHICLE")
+	{
+		// VRPTW format
+		isTimeWindowConstraint = true;
+
+		// Get the number of vehicles and the capacity of the vehicles
+		getline(inputFile, content);  // NUMBER    CAPACITY
+		inputFile >> nbVehicles >> vehicleCapacity;
+
+		// Skip the next four lines
+		getline(inputFile, content);
+		getline(inputFile, content);
+		getline(inputFile, content);
+		getline(inputFile, content);
+
+		// Create a vector where all information on the Clients can be stored and loop over all information in the file
+		cli = std::vector<Client>(1001);
+		nbClients = 0;
+		while (inputFile >> node)
+		{
+			// Store all the information of the next client
+			cli[nbClients].custNum = node;
+			inputFile >> cli[nbClients].coordX >> cli[nbClients].coordY >> cli[nbClients].demand >> cli[nbClients].earliestArrival >> cli[nbClients].latestArrival >> cli[nbClients].serviceDuration;
+			
+			// Scale coordinates by factor 10, later the distances will be rounded so we optimize with 1 decimal distances
+			cli[nbClients].coordX *= 10;
+			cli[nbClients].coordY *= 10;
+			cli[nbClients].earliestArrival *= 10;
+			cli[nbClients].latestArrival *= 10;
+			cli[nbClients].serviceDuration *= 10;
+			cli[nbClients].polarAngle = CircleSector::positive_mod(static_cast<int>(32768. * atan2(cli[nbClients].coordY - cli[0].coordY, cli[nbClients].coordX - cli[0].coordX) / PI));
+			
+			// Keep track of the max demand, the total demand, and the number of clients
+			if (cli[nbClients].demand > maxDemand)
+			{
+				maxDemand = cli[nbClients].demand;
+			}
+			totalDemand += cli[nbClients].demand;
+			nbClients++;
+		}
+
+		// Reduce the size of the vector of clients if possible
+		cli.resize(nbClients);
+
+		// Don't count depot as client
+		nbClients--;
+
+		// Check if the required service and the start of the time window of the depot are both zero
+		if (cli[0].earliestArrival != 0)
+		{
+			throw std::string("Time window for depot should start at 0");
+		}
+		if (cli[0].serviceDuration != 0)
+		{
+			throw std::string("Service duration for depot should be 0");
+		}
+	}
+	else
+	{
+		// CVRP or VRPTW according to VRPLib format
+		for (inputFile >> content; content != "EOF"; inputFile >> content)
+		{
+			// Read the dimension of the problem (the number of clients)
+			if (content == "DIMENSION")
+			{
+				// Need to substract the depot from the number of nodes
+				inputFile >> content2 >> nbClients;
+				nbClients--;
+			}
+			// Read the type of edge weights
+			else if (content == "EDGE_WEIGHT_TYPE")
+			{
+				inputFile >> content2 >> content3;
+				if (content3 == "EXPLICIT")
+				{
+					isExplicitDistanceMatrix = true;
+				}
+			}
+			else if (content == "EDGE_WEIGHT_FORMAT")
+			{
+				inputFile >> content2 >> content3;
+				if (!isExplicitDistanceMatrix)
+				{
+					throw std::string("EDGE_WEIGHT_FORMAT can only be used with EDGE_WEIGHT_TYPE : EXPLICIT");
+				}
+
+				if (content3 != "FULL_MATRIX")
+				{
+					throw std::string("EDGE_WEIGHT_FORMAT only supports FULL_MATRIX");
+				}
+			}
+			else if (content == "CAPACITY")
+			{
+				inputFile >> content2 >> vehicleCapacity;
+			}
+			else if (content == "VEHICLES" || content == "SALESMAN")
+			{
+                    // Set vehicle count from instance only if not specified on CLI.
+                    inputFile >> content2;
+                    if(nbVehicles == INT_MAX) {
+                        inputFile >> nbVehicles;
+                    } else {
+                        // Discard vehicle count
+                        int _;
+                        inputFile >> _;
+                    }
+			}
+			else if (content == "DISTANCE")
+			{
+				inputFile >> content2 >> durationLimit; isDurationConstraint = true;
+			}
+			// Read the data on the service time (used when the service time is constant for all clients)
+			else if (content == "SERVICE_TIME")
+			{
+				inputFile >> content2 >> serviceTimeData;
+			}
+			// Read the edge weights of an explicit distance matrix
+			else if (content == "EDGE_WEIGHT_SECTION")
+			{
+				if (!isExplicitDistanceMatrix)
+				{
+					throw std::string("EDGE_WEIGHT_SECTION can only be used with EDGE_WEIGHT_TYPE : EXPLICIT");
+				}
+				maxDist = 0;
+				timeCost = Matrix(nbClients + 1);
+				for (int i = 0; i <= nbClients; i++)
+				{
+					for (int j = 0; j <= nbClients; j++)
+					{
+						// Keep track of the largest distance between two clients (or the depot)
+						int cost;
+						inputFile >> cost;
+						if (cost > maxDist)
+						{
+							maxDist = cost;
+						}
+						timeCost.set(i, j, cost);
+					}
+				}
+			}
+			else if (content == "NODE_COORD_SECTION")
+			{
+				// Reading client coordinates
+				cli = std::vector<Client>(nbClients + 1);
+				for (int i = 0; i <= nbClients; i++)
+				{
+					inputFile >> cli[i].custNum >> cli[i].coordX >> cli[i].coordY;
+					
+					// Check if the clients are in order
+					if (cli[i].custNum != i + 1)
+					{
+						throw std::string("Clients are not in order in the list of coordinates");
+					}
+
+					cli[i].custNum--;
+					cli[i].polarAngle = CircleSector::positive_mod(static_cast<int>(32768. * atan2(cli[i].coordY - cli[0].coordY, cli[i].coordX - cli[0].coordX) / PI));
+				}
+			}
+			// Read the demand of each client (including the depot, which should have demand 0)
+			else if (content == "DEMAND_SECTION")
+			{
+				for (int i = 0; i <= nbClients; i++)
+				{
+					int clientNr = 0;
+					inputFile >> clientNr >> cli[i].demand;
+
+					// Check if the clients are in order
+					if (clientNr != i + 1)
+					{
+						throw std::string("Clients are not in order in the list of demands");
+					}
+
+					// Keep track of the max and total demand
+					if (cli[i].demand > maxDemand)
+					{
+						maxDemand = cli[i].demand;
+					}
+					totalDemand += cli[i].demand;
+				}
+				// Check if the depot has demand 0
+				if (cli[0].demand != 0)
+				{
+					throw std::string("Depot demand is not zero, but is instead: " + std::to_string(cli[0].serviceDuration));
+				}
+			}
+			else if (content == "DEPOT_SECTION")
+			{
+				inputFile >> content2 >> content3;
+				if (content2 != "1")
+				{
+					throw std::string("Expected depot index 1 instead of " + content2);
+				}
+			}
+			else if (content == "SERVICE_TIME_SECTION")
+			{
+				for (int i = 0; i <= nbClients; i++)
+				{
+					int clientNr = 0;
+					inputFile >> clientNr >> cli[i].serviceDuration;
+
+					// Check if the clients are in order
+					if (clientNr != i + 1)
+					{
+						throw std::string("Clients are not in order in the list of service times");
+					}
+				}
+				// Check if the service duration of the depot is 0
+				if (cli[0].serviceDuration != 0)
+				{
+					throw std::string("Service duration for depot should be 0");
+				}
+				hasServiceTimeSection = true;
+			}
+			else if (content == "RELEASE_TIME_SECTION")
+			{
+				for (int i = 0; i <= nbClients; i++)
+				{
+					int clientNr = 0;
+					inputFile >> clientNr >> cli[i].releaseTime;
+
+					// Check if the clients are in order
+					if (clientNr != i + 1)
+					{
+						throw std::string("Clients are not in order in the list of release times");
+					}
+				}
+				// Check if the service duration of the depot is 0
+				if (cli[0].releaseTime != 0)
+				{
+					throw std::string("Release time for depot should be 0");
+				}
+			}
+			// Read the time windows of all the clients (the depot should have a time window from 0 to max)
+			else if (content == "TIME_WINDOW_SECTION")
+			{
+				isTimeWindowConstraint = true;
+				for (int i = 0; i <= nbClients; i++)
+				{
+					int clientNr = 0;
+					inputFile >> clientNr >> cli[i].earliestArrival >> cli[i].latestArrival;
+
+					// Check if the clients are in order
+					if (clientNr != i + 1)
+					{
+						throw std::string("Clients are not in order in the list of time windows");
+					}
+				}
+
+				// Check the start of the time window of the depot
+				if (cli[0].earliestArrival != 0)
+				{
+					throw std::string("Time window for depot should start at 0");
+				}
+			}
+			else
+			{
+				throw std::string("Unexpected data in input file: " + content);
+			}
+		}
+
+		if (!hasServiceTimeSection)
+		{
+			for (int i = 0; i <= nbClients; i++)
+			{
+				cli[i].serviceDuration = (i == 0) ? 0 : serviceTimeData;
+			}
+		}
+
+		if (nbClients <= 0)
+		{
+			throw std::string("Number of nodes is undefined");
+		}
+		if (vehicleCapacity == INT_MAX)
+		{
+			throw std::string("Vehicle capacity is undefined");
+		}
+	}
+}
+
+bool InstanceData::isBinaryInstance(const std::string& pathInstance)
+{
+	char magic[sizeof(binaryMagic)] = {};
+	std::ifstream inputFile(pathInstance, std::ios::binary);
+	inputFile.read(magic, sizeof(magic));
+	return inputFile.good() && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+}
+
+std::shared_ptr<const void> InstanceData::mapFile(const std::string& path, size_t& size)
+{
+#ifdef _WIN32
+	// Fallback without memory mapping: read the whole file in a buffer
+	std::ifstream inputFile(path, std::ios::binary | std::ios::ate);
+	if (!inputFile.is_open())
+	{
+		throw std::invalid_argument("Impossible to open instance file: " + path);
+	}
+	size = static_cast<size_t>(inputFile.tellg());
+	std::shared_ptr<char[]> buffer(new char[size]);
+	inputFile.seekg(0);
+	inputFile.read(buffer.get(), size);
+	return std::shared_ptr<const void>(buffer, buffer.get());
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat fileStatus;
+	if (fd < 0 || fstat(fd, &fileStatus) < 0)
+	{
+		throw std::invalid_argument("Impossible to open instance file: " + path);
+	}
+	size = static_cast<size_t>(fileStatus.st_size);
+	void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED)
+	{
+		throw std::string("Impossible to map instance file in memory: " + path);
+	}
+	return std::shared_ptr<const void>(address, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+#endif
+}
+
+void InstanceData::readBinary(const std::string& pathInstance)
+{
+	// The matrix is used directly from the file, which requires the byte order of the file (little endian)
+	if constexpr (std::endian::native != std::endian::little)
+	{
+		throw std::string("Binary instances can only be used on little endian machines");
+	}
+
+	size_t size;
+	std::shared_ptr<const void> file = mapFile(pathInstance, size);
+	const char* data = static_cast<const char*>(file.get());
+
+	// Read the header (see InstanceData.h for the format)
+	auto readInt = [data](size_t offset) { int32_t value; std::memcpy(&value, data + offset, sizeof(value)); return static_cast<int>(value); };
+	if (size < binaryHeaderSize)
+	{
+		throw std::string("Binary instance file is too small: " + pathInstance);
+	}
+	int nbNodes = readInt(8);
+	if (nbNodes < 2 || size != binaryHeaderSize + sizeof(int32_t) * (static_cast<size_t>(nbNodes) * nbNodes + 7 * static_cast<size_t>(nbNodes)))
+	{
+		throw std::string("Binary instance file has an incorrect size: " + pathInstance);
+	}
+	nbClients = nbNodes - 1;
+	vehicleCapacity = readInt(12);
+	if (nbVehicles == INT_MAX && readInt(16) > 0)
+	{
+		nbVehicles = readInt(16);
+	}
+	durationLimit = readInt(20) > 0 ? readInt(20) : INT_MAX;
+	isDurationConstraint = readInt(20) > 0;
+	isTimeWindowConstraint = (readInt(24) & 1) != 0;
+	isExplicitDistanceMatrix = true;
+	maxDist = readInt(28);
+	instanceName = std::string(data + 32, strnlen(data + 32, 96));
+
+	// The matrix is not copied: timeCost keeps the mapped file alive
+	const int* matrix = reinterpret_cast<const int*>(data + binaryHeaderSize);
+	timeCost = Matrix(nbNodes, matrix, file);
+
+	// Client data: one array per attribute, following the matrix
+	const int* arrays = matrix + static_cast<size_t>(nbNodes) * nbNodes;
+	cli = std::vector<Client>(nbNodes);
+	totalDemand = 0;
+	maxDemand = 0;
+	for (int i = 0; i < nbNodes; i++)
+	{
+		cli[i].custNum = i;
+		cli[i].coordX = arrays[i];
+		cli[i].coordY = arrays[nbNodes + i];
+		cli[i].demand = arrays[2 * nbNodes + i];
+		cli[i].serviceDuration = arrays[3 * nbNodes + i];
+		cli[i].earliestArrival = arrays[4 * nbNodes + i];
+		cli[i].latestArrival = arrays[5 * nbNodes + i];
+		cli[i].releaseTime = arrays[6 * nbNodes + i];
+		cli[i].polarAngle = CircleSector::positive_mod(static_cast<int>(32768. * atan2(cli[i].coordY - cli[0].coordY, cli[i].coordX - cli[0].coordX) / PI));
+
+		// Keep track of the max and total demand
+		if (cli[i].demand > maxDemand)
+		{
+			maxDemand = cli[i].demand;
+		}
+		totalDemand += cli[i].demand;
+	}
+
+	// Same checks as for the text format
+	if (cli[0].demand != 0)
+	{
+		throw std::string("Depot demand is not zero, but is instead: " + std::to_string(cli[0].demand));
+	}
+	if (cli[0].serviceDuration != 0)
+	{
+		throw std::string("Service duration for depot should be 0");
+	}
+	if (cli[0].earliestArrival != 0)
+	{
+		throw std::string("Time window for depot should start at 0");
+	}
+}
+
+void InstanceData::computeDerivedData()
+{
+	// Default initialization if the number of vehicles has not been provided by the user
+	if (nbVehicles == INT_MAX)
+	{
+		// Safety margin: 30% + 3 more vehicles than the trivial bin packing LB
+		nbVehicles = static_cast<int>(std::ceil(1.3 * totalDemand / vehicleCapacity) + 3.);
+		std::cout << "----- FLEET SIZE WAS NOT SPECIFIED: DEFAULT INITIALIZATION TO " << nbVehicles << " VEHICLES" << std::endl;
+	}
+	else if (nbVehicles == -1)
+	{
+		nbVehicles = nbClients;
+		std::cout << "----- FLEET SIZE UNLIMITED: SET TO UPPER BOUND OF " << nbVehicles << " VEHICLES" << std::endl;
+	}
+	else
+	{
+		std::cout << "----- FLEET SIZE SPECIFIED IN THE COMMANDLINE: SET TO " << nbVehicles << " VEHICLES" << std::endl;
+	}
+
+	if (!isExplicitDistanceMatrix)
+	{
+		// Calculation of the distance matrix
+		maxDist = 0;
+		timeCost = Matrix(nbClients + 1);
+		// Loop over all clients (including the depot)
+		for (int i = 0; i <= nbClients; i++)
+		{
+			// Set the diagonal element to zero (travel to itself)
+			timeCost.set(i, i, 0);
+			// Loop over all other clients
+			for (int j = i + 1; j <= nbClients; j++)
+			{
+				// Calculate Euclidian distance d
+				double d = std::sqrt((cli[i].coordX - cli[j].coordX) * (cli[i].coordX - cli[j].coordX) + (cli[i].coordY - cli[j].coordY) * (cli[i].coordY - cli[j].coordY));
+				// Integer truncation
+				int cost = static_cast<int>(d);
+				// Keep track of the max distance
+				if (cost > maxDist)
+				{
+					maxDist = cost;
+				}
+				// Save the distances in the matrix
+				timeCost.set(i, j, cost);
+				timeCost.set(j, i, cost);
+			}
+		}
+	}
+	
+
+	// The clients are numbered as in the instance file (until they are reordered)
+	originalIndex = std::vector<int>(nbClients + 1);
+	std::iota(originalIndex.begin(), originalIndex.end(), 0);
+	internalIndex = originalIndex;
+
+	// The order proximities are computed when they are first needed (see getOrderProximities)
+
+	// Safeguards to avoid possible numerical instability in case of instances containing arbitrarily small or large numerical values
+	if (maxDist < 0.1 || maxDist > 100000)
+	{
+		throw std::string("The distances are of very small or large scale. This could impact numerical stability. Please rescale the dataset and run again.");
+	}
+	if (maxDemand < 0.1 || maxDemand > 100000)
+	{
+		throw std::string("The demand quantities are of very small or large scale. This could impact numerical stability. Please rescale the dataset and run again.");
+	}
+	if (nbVehicles < std::ceil(totalDemand / vehicleCapacity))
+	{
+		throw std::string("Fleet size is insufficient to service the considered clients.");
+	}
+
+	// Store the distance matrix with 16-bit elements if the distances allow it
+	if (maxDist <= UINT16_MAX)
+	{
+		timeCost.narrow();
+	}
+}
+
+std::shared_ptr<const InstanceData::ProximityLists> InstanceData::getOrderProximities(int k) const
+{
+	std::lock_guard<std::mutex> lock(orderProximitiesMutex);
+	k = std::min(k, nbClients - 1);
+	if (orderProximities == nullptr || nbOrderProximities < k)
+	{
+		// Compute (at least) twice as many proximities as before, such that the lists are rarely recomputed when nbGranular grows
+		nbOrderProximities = std::min(std::max(k, 2 * nbOrderProximities), nbClients - 1);
+		orderProximities = computeOrderProximities(nbOrderProximities);
+	}
+	return orderProximities;
+}
+
+std::shared_ptr<const InstanceData::ProximityLists> InstanceData::computeOrderProximities(int k) const
+{
+	auto proximities = std::make_shared<ProximityLists>(nbClients + 1);
+
+	// Computes the order proximities of the clients in [firstClient, lastClient) (one range per thread)
+	auto computeRange = [this, k, &proximities](int firstClient, int lastClient)
+	{
+		std::vector<std::pair<double, int>> orderProximity;
+		orderProximity.reserve(nbClients);
+		for (int i = firstClient; i < lastClient; i++)
+		{
+			// Loop over all clients (excluding the depot and the specific client itself)
+			orderProximity.clear();
+			for (int j = 1; j <= nbClients; j++)
+			{
+				if (i != j)
+				{
+					// Compute proximity using Eq. 4 in Vidal 2012, and append at the end of orderProximity
+					const int timeIJ = timeCost.get(i, j);
+					orderProximity.emplace_back(
+						timeIJ
+						+ std::min(
+							proximityWeightWaitTime * std::max(cli[j].earliestArrival - timeIJ - cli[i].serviceDuration - cli[i].latestArrival, 0)
+							+ proximityWeightTimeWarp * std::max(cli[i].earliestArrival + cli[i].serviceDuration + timeIJ - cli[j].latestArrival, 0),
+							proximityWeightWaitTime * std::max(cli[i].earliestArrival - timeIJ - cli[j].serviceDuration - cli[j].latestArrival, 0)
+							+ proximityWeightTimeWarp * std::max(cli[j].earliestArrival + cli[j].serviceDuration + timeIJ - cli[i].latestArrival, 0)),
+						j);
+				}
+			}
+
+			// Only keep the k closest clients, sorted (pairs are compared on both elements, so the result equals the first k elements of a full sort)
+			std::partial_sort(orderProximity.begin(), orderProximity.begin() + k, orderProximity.end());
+			(*proximities)[i].assign(orderProximity.begin(), orderProximity.begin() + k);
+		}
+	};
+
+	// Divide the clients (excluding the depot) over the threads
+	int nbThreads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), nbClients / 64));
+	std::vector<std::thread> threads;
+	for (int t = 1; t < nbThreads; t++)
+	{
+		threads.emplace_back(computeRange, 1 + t * nbClients / nbThreads, 1 + (t + 1) * nbClients / nbThreads);
+	}
+	computeRange(1, 1 + nbClients / nbThreads);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	return proximities;
+}
+
+// Index of the point (x, y) on the Hilbert curve filling the grid of size 2^order by 2^order
+static uint64_t hilbertIndex(uint32_t x, uint32_t y, int order)
+{
+	uint64_t index = 0;
+	for (uint32_t s = 1u << (order - 1); s > 0; s /= 2)
+	{
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+		// Rotate the quadrant, such that the curve is continuous
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = s - 1 - (x & (s - 1));
+				y = s - 1 - (y & (s - 1));
+			}
+			std::swap(x, y);
+		}
+	}
+	return index;
+}
+
+void InstanceData::reorderClients()
+{
+	// Position of each client on a Hilbert curve through the bounding box of the coordinates (grid of 2^16 by 2^16 cells)
+	const int order = 16;
+	int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
+	for (int i = 1; i <= nbClients; i++)
+	{
+		minX = std::min(minX, cli[i].coordX);
+		maxX = std::max(maxX, cli[i].coordX);
+		minY = std::min(minY, cli[i].coordY);
+		maxY = std::max(maxY, cli[i].coordY);
+	}
+	double scale = ((1 << order) - 1) / std::max(1., static_cast<double>(std::max(maxX - minX, maxY - minY)));
+	std::vector<uint64_t> curveIndex(nbClients + 1);
+	for (int i = 1; i <= nbClients; i++)
+	{
+		curveIndex[i] = hilbertIndex(static_cast<uint32_t>((cli[i].coordX - minX) * scale), static_cast<uint32_t>((cli[i].coordY - minY) * scale), order);
+	}
+
+	// New order of the clients (the depot stays at index 0). Clients at the same position keep their relative order
+	std::vector<int> newOrder(nbClients + 1);
+	std::iota(newOrder.begin(), newOrder.end(), 0);
+	std::stable_sort(newOrder.begin() + 1, newOrder.end(), [&curveIndex](int a, int b) { return curveIndex[a] < curveIndex[b]; });
+
+	// Permute the clients and the distance matrix (which becomes owned by this object, also if it was memory mapped)
+	std::vector<Client> newCli(nbClients + 1);
+	Matrix newTimeCost(nbClients + 1);
+	for (int i = 0; i <= nbClients; i++)
+	{
+		newCli[i] = cli[newOrder[i]];
+		for (int j = 0; j <= nbClients; j++)
+		{
+			newTimeCost.set(i, j, timeCost.get(newOrder[i], newOrder[j]));
+		}
+	}
+	cli = std::move(newCli);
+	timeCost = std::move(newTimeCost);
+	if (maxDist <= UINT16_MAX)
+	{
+		timeCost.narrow();
+	}
+
+	// Compose with the previous numbering, and discard the order proximities (which use the previous numbering)
+	std::vector<int> newOriginalIndex(nbClients + 1);
+	for (int i = 0; i <= nbClients; i++)
+	{
+		newOriginalIndex[i] = originalIndex[newOrder[i]];
+		internalIndex[newOriginalIndex[i]] = i;
+	}
+	originalIndex = std::move(newOriginalIndex);
+	orderProximities = nullptr;
+	nbOrderProximities = 0;
+}
@@ -0,0 +1,139 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#ifndef INSTANCEDATA_H
+#define INSTANCEDATA_H
+
+#include <climits>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+
+#include "Matrix.h"
+
+#define MY_EPSILON 0.00001		// Precision parameter, used to avoid numerical instabilities
+#define PI 3.14159265359		// Number pi, with 11 decimal precision
+
+// Structure of a Client, including its index, position, and all other variables and parameters
+struct Client
+{
+	int custNum;			// Index of the client
+	int coordX;				// Coordinate X
+	int coordY;				// Coordinate Y
+	int serviceDuration;	// Service duration
+	int demand;				// Demand
+	int earliestArrival;	// Earliest arrival (when using time windows)
+	int latestArrival;		// Latest arrival (when using time windows)
+	int releaseTime;	// Release time (when using time windows, route containing this customer cannot depart before this time)
+	int polarAngle;			// Polar angle of the client around the depot (starting at east, moving counter-clockwise), measured in degrees and truncated for convenience
+};
+
+// Class that stores the data of a problem instance. It is loaded once and never modified afterwards,
+// so that it can be shared (as std::shared_ptr<const InstanceData>) by all search contexts (Params) running on the same instance.
+// Aligned to a cache line so that no mutable data of another object ends up on the same cache line.
+class alignas(64) InstanceData
+{
+public:
+	static constexpr double proximityWeightWaitTime = 0.2;			// Weight for waiting time in defining the neighbourhood proximities (see Vidal 2012, HGS for VRPTW)
+	static constexpr double proximityWeightTimeWarp = 1.;			// Weight for time warp in defining the neighbourhood proximities (see Vidal 2012, HGS for VRPTW)
+
+	std::string instanceName;											// Name of the instance (first line of the file)
+	bool isDurationConstraint;											// Indicates if the problem includes duration constraints
+	bool isTimeWindowConstraint;										// Indicates if the problem includes time window constraints
+	bool isExplicitDistanceMatrix;										// Indicates if the problem is with explicit distances (non-euclidean)
+	int nbClients;														// Number of clients (excluding the depot)
+	int nbVehicles;														// Number of vehicles
+	int durationLimit;													// Route duration limit
+	int vehicleCapacity;												// Capacity limit
+	int totalDemand;													// Total demand required by the clients
+	int maxDemand;														// Maximum demand of a client
+	int maxDist;														// Maximum distance between two clients
+	std::vector<Client> cli;											// Vector containing information on each client (including the depot!)
+	Matrix timeCost;													// Distance matrix (including the depot!)
+	std::vector<int> originalIndex;										// For each client (internal index), its index in the instance file (see reorderClients)
+	std::vector<int> internalIndex;										// For each client (index in the instance file), its internal index
+
+	// For each client, the closest other clients sorted by proximity (size nbClients + 1, but nothing stored for the depot!)
+	using ProximityLists = std::vector<std::vector<std::pair<double, int>>>;
+
+	// Reads the instance from pathInstance, which can be a text (VRPLIB or Solomon) or a binary instance file.
+	// nbVeh is the number of vehicles given on the command line (INT_MAX if not given, -1 if unlimited). If isReorderClients, the clients are renumbered (see reorderClients)
+	InstanceData(const std::string& pathInstance, int nbVeh, bool isReorderClients = false);
+
+	// Reads the instance from a text buffer (for example an instance received in server mode)
+	static std::shared_ptr<const InstanceData> fromText(std::string_view text, int nbVeh, bool isReorderClients = false);
+
+	// Empty instance, to be filled with the functions below
+	InstanceData() : nbVehicles(INT_MAX) {}
+
+	// Binary instance format (all integers are 32-bit little endian), written by tools.write_binary_instance:
+	//		- header of 128 bytes: magic "HGSVRPB1", number of nodes n (including the depot), vehicle capacity, number of vehicles (0 if not specified),
+	//		  duration limit (0 if none), flags (bit 0: time windows), maximum distance, instance name (96 bytes, zero padded)
+	//		- the n x n duration matrix (row-major)
+	//		- arrays of size n with, respectively, coordX, coordY, demand, service duration, earliest arrival, latest arrival and release time
+	// The file is memory mapped and the matrix is used without copying it
+	static constexpr char binaryMagic[8] = { 'H', 'G', 'S', 'V', 'R', 'P', 'B', '1' };
+	static constexpr size_t binaryHeaderSize = 128;
+
+	// Reads the instance from a text buffer containing the whole instance file, tokenized in place with std::from_chars
+	void readText(std::string_view buffer);
+
+	// Reads the instance from inputFile in text format, using stream extraction (original parser, kept as a reference for benchmarks)
+	void readTextStream(std::istream& inputFile);
+
+	// Reads the instance from a binary instance file
+	void readBinary(const std::string& pathInstance);
+
+	// Computes the number of vehicles (if not given) and the distance matrix (if not explicit), and checks the data
+	void computeDerivedData();
+
+	// Renumbers the clients (not the depot) along a Hilbert curve through their coordinates, such that clients that are close to each other
+	// also have close indices. The neighbours of a client then have their data (in cli and timeCost) in nearby memory, which gives fewer cache misses.
+	// The clients keep their original index in originalIndex, which is used to read and write solutions
+	void reorderClients();
+
+	// Returns, for each client, (at least) the k closest other clients sorted by proximity (or all other clients if there are fewer).
+	// The lists are computed at the first call and recomputed (for more clients) when a larger k is asked. Can be called from several threads
+	std::shared_ptr<const ProximityLists> getOrderProximities(int k) const;
+
+private:
+	mutable std::mutex orderProximitiesMutex;							// Protects orderProximities and nbOrderProximities
+	mutable std::shared_ptr<const ProximityLists> orderProximities;		// Order proximities computed so far (nullptr before the first call to getOrderProximities)
+	mutable int nbOrderProximities = 0;									// Number of clients in each list of orderProximities
+
+	// Computes, for each client, the k closest other clients sorted by proximity, dividing the clients over several threads
+	std::shared_ptr<const ProximityLists> computeOrderProximities(int k) const;
+
+	// Tells whether the file at pathInstance is a binary instance file (starting with binaryMagic)
+	static bool isBinaryInstance(const std::string& pathInstance);
+
+	// Maps the file at path in memory (read-only) and sets size to its size. The memory stays valid as long as the returned pointer (or a copy of it) is alive
+	static std::shared_ptr<const void> mapFile(const std::string& path, size_t& size);
+};
+
+#endif
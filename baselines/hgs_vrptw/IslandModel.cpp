@@ -0,0 +1,164 @@
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "IslandModel.h"
+#include "Params.h"
+#include "Split.h"
+#include "LocalSearch.h"
+#include "Population.h"
+#include "Genetic.h"
+#include "Individual.h"
+
+void IslandModel::run(int maxIterNonProd, int timeLimit)
+{
+	// Start one thread per island. Exceptions cannot cross thread boundaries, so they are stored and rethrown after all threads have finished
+	std::vector<std::thread> threads;
+	std::vector<std::exception_ptr> exceptions(islands.size());
+	for (int i = 0; i < static_cast<int>(islands.size()); i++)
+	{
+		threads.emplace_back([this, i, maxIterNonProd, timeLimit, &exceptions]
+		{
+			try
+			{
+				runIsland(i, maxIterNonProd, timeLimit);
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception();
+			}
+		});
+	}
+
+	// Wait until all islands are finished
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const std::exception_ptr& exception : exceptions)
+	{
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+void IslandModel::runIsland(int islandIdx, int maxIterNonProd, int timeLimit)
+{
+	// The data structures are created in the thread of the island, such that the initial populations are also generated in parallel
+	Island& island = islands[islandIdx];
+	island.split = std::make_unique<Split>(island.params);
+	island.localSearch = std::make_unique<LocalSearch>(island.params);
+	island.population = std::make_unique<Population>(island.params, island.split.get(), island.localSearch.get(), this, islandIdx);
+	island.solver = std::make_unique<Genetic>(island.params, island.split.get(), island.population.get(), island.localSearch.get(), this, islandIdx);
+	island.solver->run(maxIterNonProd, timeLimit);
+}
+
+bool IslandModel::migrate(int islandIdx, Population* population)
+{
+	int previousIslandIdx = (islandIdx + static_cast<int>(islands.size()) - 1) % static_cast<int>(islands.size());
+	std::vector<Migrant> receivedMigrants;
+	{
+		std::lock_guard<std::mutex> lock(migrationMutex);
+
+		// Send copies of the elite individuals to the next island (this replaces the migrants that were sent previously)
+		migrants[islandIdx].clear();
+		for (const Individual* indiv : population->getBestIndividuals(params->config.nbMigrants))
+		{
+			migrants[islandIdx].push_back({ indiv->chromT, indiv->chromR });
+		}
+		migrantsVersion[islandIdx]++;
+
+		// Receive the migrants of the previous island, only if they have not been received before
+		if (migrantsVersion[previousIslandIdx] > migrantsVersionReceived[islandIdx])
+		{
+			receivedMigrants = migrants[previousIslandIdx];
+			migrantsVersionReceived[islandIdx] = migrantsVersion[previousIslandIdx];
+		}
+	}
+
+	// Add the migrants to the population, outside of the lock. The migrants are evaluated again with the penalties of this island
+	bool isNewBest = false;
+	Params* islandParams = islands[islandIdx].params;
+	for (const Migrant& migrant : receivedMigrants)
+	{
+		Individual indiv(islandParams, false);
+		indiv.chromT = migrant.chromT;
+		indiv.chromR = migrant.chromR;
+		indiv.evaluateCompleteCost();
+		isNewBest = (population->addIndividual(&indiv, false) || isNewBest);
+	}
+	return isNewBest;
+}
+
+void IslandModel::reportBest(Individual* indiv)
+{
+	std::lock_guard<std::mutex> lock(migrationMutex);
+	if (indiv->myCostSol.penalizedCost < bestCostOverall - MY_EPSILON)
+	{
+		bestCostOverall = indiv->myCostSol.penalizedCost;
+		if (params->config.isDimacsRun)
+		{
+			// Print solution for processing by the controller, only when it improves the best solution over all islands
+			indiv->printCVRPLibFormat();
+		}
+	}
+}
+
+Population* IslandModel::getBestPopulation()
+{
+	Population* bestPopulation = nullptr;
+	for (Island& island : islands)
+	{
+		if (island.population != nullptr && island.population->getBestFound() != nullptr
+			&& (bestPopulation == nullptr || island.population->getBestFound()->myCostSol.penalizedCost < bestPopulation->getBestFound()->myCostSol.penalizedCost))
+		{
+			bestPopulation = island.population.get();
+		}
+	}
+	return bestPopulation;
+}
+
+LocalSearchStatistics IslandModel::getLocalSearchStatistics() const
+{
+	LocalSearchStatistics statistics;
+	for (const Island& island : islands)
+	{
+		if (island.localSearch != nullptr)
+		{
+			statistics.add(island.localSearch->getStatistics());
+		}
+	}
+	return statistics;
+}
+
+IslandModel::IslandModel(Params* params, int nbIslands) : params(params), bestCostOverall(1.e30)
+{
+	islands = std::vector<Island>(nbIslands);
+	migrants = std::vector<std::vector<Migrant>>(nbIslands);
+	migrantsVersion = std::vector<int>(nbIslands, 0);
+	migrantsVersionReceived = std::vector<int>(nbIslands, 0);
+
+	// The first island uses the given parameters, the other islands use a copy with a different seed (the copies are made before any island starts)
+	islands[0].params = params;
+	for (int i = 1; i < nbIslands; i++)
+	{
+		islands[i].ownedParams = std::make_unique<Params>(*params);
+		islands[i].ownedParams->rng = XorShift128(params->config.seed + i);
+		islands[i].params = islands[i].ownedParams.get();
+	}
+}
+
+IslandModel::~IslandModel()
+{
+	// Destruct the islands in reverse order of construction of their data structures
+	for (Island& island : islands)
+	{
+		island.solver.reset();
+		island.population.reset();
+		island.localSearch.reset();
+		island.split.reset();
+	}
+}
@@ -0,0 +1,98 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#ifndef ISLANDMODEL_H
+#define ISLANDMODEL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Params.h"
+#include "Split.h"
+#include "LocalSearch.h"
+#include "Population.h"
+#include "Genetic.h"
+#include "Individual.h"
+
+// Class to run several independent genetic algorithms (islands) in parallel, one per thread.
+// Each island has its own Params (and thus its own random number generator and penalties), Split, LocalSearch and Population.
+// Every migrationInterval iterations, an island sends copies of its elite individuals to the next island (ring topology).
+class IslandModel
+{
+public:
+	// Running all islands in parallel until each of them reaches the termination criterion of Genetic::run
+	void run(int maxIterNonProd, int timeLimit);
+
+	// Sends the elite individuals of island islandIdx to the next island, and adds the migrants received from the previous island to its population
+	// Returns TRUE if one of the migrants is a new best solution of the island
+	bool migrate(int islandIdx, Population* population);
+
+	// Registers a new best solution found by one of the islands. In a DIMACS run, the solution is printed if it improves the best solution over all islands
+	void reportBest(Individual* indiv);
+
+	// Accesses the population of the island that found the best solution. If no solution was found, return nullptr
+	Population* getBestPopulation();
+
+	// Sums the counters of the local searches of all islands (only updated if compiled with LS_STATISTICS)
+	LocalSearchStatistics getLocalSearchStatistics() const;
+
+	// Constructor, the first island uses params, the other islands use a copy of it with a different seed
+	IslandModel(Params* params, int nbIslands);
+
+	// Destructor
+	~IslandModel();
+
+private:
+	// Solution sent from one island to the next one (only the representation, since the cost is evaluated by the receiving island)
+	struct Migrant
+	{
+		std::vector<int> chromT;						// Giant tour of the solution
+		std::vector<std::vector<int>> chromR;			// Routes of the solution
+	};
+
+	// All data structures of one island
+	struct Island
+	{
+		Params* params;									// Problem parameters of this island
+		std::unique_ptr<Params> ownedParams;			// Copy of the search state, sharing the instance data (for all islands except the first one)
+		std::unique_ptr<Split> split;					// Split algorithm of this island
+		std::unique_ptr<LocalSearch> localSearch;		// Local search structure of this island
+		std::unique_ptr<Population> population;			// Population of this island
+		std::unique_ptr<Genetic> solver;				// Genetic algorithm of this island
+	};
+
+	Params* params;										// Problem parameters of the first island
+	std::vector<Island> islands;						// All islands
+	std::mutex migrationMutex;							// Protects the migrants and the best solution over all islands
+	std::vector<std::vector<Migrant>> migrants;			// For each island, the elite individuals it sent most recently
+	std::vector<int> migrantsVersion;					// For each island, the number of times it sent migrants
+	std::vector<int> migrantsVersionReceived;			// For each island, the version of the migrants it received most recently from the previous island
+	double bestCostOverall;								// Penalized cost of the best solution over all islands
+
+	// Creates the data structures of island islandIdx and runs its genetic algorithm (executed in the thread of the island)
+	void runIsland(int islandIdx, int maxIterNonProd, int timeLimit);
+};
+
+#endif
@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <vector>
 #include <set>
+#include <thread>
 
 #include "LocalSearch.h"
 #include "Individual.h"
@@ -39,7 +41,7 @@ void LocalSearch::initializeConstruction(Individual* indiv, std::vector<NodeToIn
 	// Initializing time window data for clients
 	for (int i = 1; i <= params->nbClients; i++)
 	{
-		TimeWindowData* myTwData = &clients[i].twData;
+		TimeWindowData* myTwData = &getTwData(&clients[i]);
 		myTwData->firstNodeIndex = i;
 		myTwData->lastNodeIndex = i;
 		myTwData->duration = params->cli[i].serviceDuration;
@@ -57,14 +59,15 @@ void LocalSearch::initializeConstruction(Individual* indiv, std::vector<NodeToIn
 		myDepot->next = myDepotFin;
 		myDepotFin->prev = myDepot;
 
-		myDepot->twData = depotTwData;
-		myDepot->prefixTwData = depotTwData;
-		myDepot->postfixTwData = depotTwData;
+		getTwData(myDepot) = depotTwData;
+		getPrefixTwData(myDepot) = depotTwData;
+		getPostfixTwData(myDepot) = depotTwData;
 
-		myDepotFin->twData = depotTwData;
-		myDepotFin->prefixTwData = depotTwData;
-		myDepotFin->postfixTwData = depotTwData;
+		getTwData(myDepotFin) = depotTwData;
+		getPrefixTwData(myDepotFin) = depotTwData;
+		getPostfixTwData(myDepotFin) = depotTwData;
 
+		setRouteModified(&routes[r]);
 		updateRouteData(&routes[r]);
 	}
 
@@ -73,7 +76,7 @@ void LocalSearch::initializeConstruction(Individual* indiv, std::vector<NodeToIn
 	{
 		NodeToInsert nodeToInsert;
 		nodeToInsert.clientIdx = i;
-		nodeToInsert.twData = clients[i].twData;
+		nodeToInsert.twData = getTwData(&clients[i]);
 		nodeToInsert.load = params->cli[i].demand;
 		nodeToInsert.angleFromDepot = atan2(params->cli[i].coordY - params->cli[0].coordY, params->cli[i].coordX - params->cli[0].coordX);
 		nodeToInsert.serviceDuration = params->cli[i].serviceDuration;
@@ -114,7 +117,7 @@ void LocalSearch::constructIndividualBySweep(int fillPercentage, Individual* ind
 	// Construct routes
 	for (int r = 0; r < static_cast<int>(nodeIndicesPerRoute.size()); r++)
 	{
-		int depotOpeningDuration = depots[r].twData.latestArrival - depots[r].twData.earliestArrival;
+		int depotOpeningDuration = getTwData(&depots[r]).latestArrival - getTwData(&depots[r]).earliestArrival;
 		std::vector<int> nodeIndicesToInsertShortTw;
 		std::vector<int> nodeIndicesToInsertLongTw;
 		for (int idx : nodeIndicesPerRoute[r])
@@ -145,6 +148,7 @@ void LocalSearch::constructIndividualBySweep(int fillPercentage, Individual* ind
 			prev = toInsert;
 		}
 
+		setRouteModified(&routes[r]);
 		updateRouteData(&routes[r]);
 
 		// Insert remaining nodes according to best distance
@@ -175,6 +179,7 @@ void LocalSearch::constructIndividualBySweep(int fillPercentage, Individual* ind
 			toInsert->next = insertionPoint->next;
 			insertionPoint->next->prev = toInsert;
 			insertionPoint->next = toInsert;
+			setRouteModified(&routes[r]);
 			updateRouteData(&routes[r]);
 		}
 	}
@@ -223,6 +228,7 @@ void LocalSearch::constructIndividualWithSeedOrder(int toleratedCapacityViolatio
 			toInsert->next = routes[r].depot->next;
 			routes[r].depot->next->prev = toInsert;
 			routes[r].depot->next = toInsert;
+			setRouteModified(&routes[r]);
 			updateRouteData(&routes[r]);
 			unassignedNodeIndices.erase(furthestNodeIdx);
 		}
@@ -245,7 +251,7 @@ void LocalSearch::constructIndividualWithSeedOrder(int toleratedCapacityViolatio
 				{
 					// Do not allow insertions if time windows are violated more than tolerance
 					TimeWindowData routeTwData =
-						MergeTWDataRecursive(prev->prefixTwData, nodesToInsert[idx].twData, prev->next->postfixTwData);
+						MergeTWDataRecursive(getPrefixTwData(prev), nodesToInsert[idx].twData, getPostfixTwData(prev->next));
 					if (routeTwData.timeWarp > toleratedTimeWarp)
 					{
 						prev = prev->next;
@@ -275,6 +281,7 @@ void LocalSearch::constructIndividualWithSeedOrder(int toleratedCapacityViolatio
 				toInsert->next = bestPred->next;
 				bestPred->next->prev = toInsert;
 				bestPred->next = toInsert;
+				setRouteModified(&routes[r]);
 				updateRouteData(&routes[r]);
 				insertedNode = true;
 				unassignedNodeIndices.erase(bestNodeIdx);
@@ -301,6 +308,7 @@ void LocalSearch::constructIndividualWithSeedOrder(int toleratedCapacityViolatio
 			unassignedNodeIndices.erase(idx);
 		}
 
+		setRouteModified(&routes[lastRouteIdx]);
 		updateRouteData(&routes[lastRouteIdx]);
 	}
 
@@ -310,8 +318,10 @@ void LocalSearch::constructIndividualWithSeedOrder(int toleratedCapacityViolatio
 
 void LocalSearch::run(Individual* indiv, double penaltyCapacityLS, double penaltyTimeWarpLS)
 {
-	static const bool neverIntensify = params->config.intensificationProbabilityLS == 0;
-	static const bool alwaysIntensify = params->config.intensificationProbabilityLS == 100;
+	// Derived from the parameters of this LocalSearch at every call (and not cached in static variables),
+	// such that several LocalSearch objects with different parameters can be used in the same process
+	const bool neverIntensify = params->config.intensificationProbabilityLS == 0;
+	const bool alwaysIntensify = params->config.intensificationProbabilityLS == 100;
 	const bool runLS_INT = params->rng() % 100 < (unsigned int) params->config.intensificationProbabilityLS;
 
 	this->penaltyCapacityLS = penaltyCapacityLS;
@@ -323,7 +333,10 @@ void LocalSearch::run(Individual* indiv, double penaltyCapacityLS, double penalt
 	std::shuffle(orderRoutes.begin(), orderRoutes.end(), params->rng);
 	for (int i = 1; i <= params->nbClients; i++)
 		if (params->rng() % params->config.nbGranular == 0)  // Designed to use O(nbGranular x n) time overall to avoid possible bottlenecks
-			std::shuffle(params->correlatedVertices[i].begin(), params->correlatedVertices[i].end(), params->rng);
+		{
+			std::span<int> correlated = params->getCorrelatedVertices(i);
+			std::shuffle(correlated.begin(), correlated.end(), params->rng);
+		}
 
 	searchCompleted = false;
 	for (loopID = 0; !searchCompleted; loopID++)
@@ -338,14 +351,21 @@ void LocalSearch::run(Individual* indiv, double penaltyCapacityLS, double penalt
 		for (int posU = 0; posU < params->nbClients; posU++)
 		{
 			nodeU = &clients[orderNodes[posU]];
+			if (params->config.useDontLookBits)
+			{
+				// Skip the nodes whose moves all failed, unless their route has been modified since (see updateRouteData)
+				if (!isNodeActive[nodeU->cour]) continue;
+				isNodeActive[nodeU->cour] = false;
+			}
 			int lastTestRINodeU = nodeU->whenLastTestedRI;
 			nodeU->whenLastTestedRI = nbMoves;
 
-			const auto& correlated = params->correlatedVertices[nodeU->cour];
+			const std::span<int> correlated = params->getCorrelatedVertices(nodeU->cour);
 			
 			for (const auto& v : correlated)
 			{
 				nodeV = &clients[v];
+				LS_STATISTICS_FILTER(routeModifiedRI, loopID > 0 && std::max(nodeU->route->whenLastModified, nodeV->route->whenLastModified) <= lastTestRINodeU);
 				if (loopID == 0 || std::max(nodeU->route->whenLastModified, nodeV->route->whenLastModified) > lastTestRINodeU) // only evaluate moves involving routes that have been modified since last move evaluations for nodeU
 				{
 					// Randomizing the order of the neighborhoods within this loop does not matter much as we are already randomizing the order of the node pairs (and it's not very common to find improving moves of different types for the same node pair)
@@ -389,40 +409,57 @@ void LocalSearch::run(Individual* indiv, double penaltyCapacityLS, double penalt
 		/* (SWAP*) MOVES LIMITED TO ROUTE PAIRS WHOSE CIRCLE SECTORS OVERLAP */
 		if (!neverIntensify && searchCompleted && (alwaysIntensify || runLS_INT))
 		{
-			for (int rU = 0; rU < params->nbVehicles; rU++)
+			// Only the non-empty routes are iterated, in the order of orderRoutes (with many vehicles, most routes are empty).
+			// Routes cannot become non-empty during these moves, and routes that become empty are skipped below
+			orderNonEmptyRoutes.clear();
+			for (int r : orderRoutes)
 			{
-				routeU = &routes[orderRoutes[rU]];
-				if (routeU->nbCustomers == 0)
-				{
-					continue;
-				}
+				if (routes[r].nbCustomers > 0) orderNonEmptyRoutes.push_back(r);
+			}
 
-				int lastTestLargeNbRouteU = routeU->whenLastTestedLargeNb;
-				routeU->whenLastTestedLargeNb = nbMoves;
-				for (int rV = 0; rV < params->nbVehicles; rV++)
+			if (params->config.nbLocalSearchThreads > 1)
+			{
+				parallelSwapStar();
+			}
+			else
+			{
+				for (int rU : orderNonEmptyRoutes)
 				{
-					routeV = &routes[orderRoutes[rV]];
-					if (routeV->nbCustomers == 0 || routeU->cour >= routeV->cour)
+					routeU = &routes[rU];
+					if (routeU->nbCustomers == 0)
 					{
 						continue;
 					}
 
-					if (loopID > 0 && std::max(routeU->whenLastModified, routeV->whenLastModified) <= lastTestLargeNbRouteU)
+					int lastTestLargeNbRouteU = routeU->whenLastTestedLargeNb;
+					routeU->whenLastTestedLargeNb = nbMoves;
+					for (int rV : orderNonEmptyRoutes)
 					{
-						continue;
-					}
+						routeV = &routes[rV];
+						if (routeV->nbCustomers == 0 || routeU->cour >= routeV->cour)
+						{
+							continue;
+						}
 
-					if (!CircleSector::overlap(routeU->sector, routeV->sector, params->circleSectorOverlapTolerance))
-					{
-						continue;
-					}
+						LS_STATISTICS_FILTER(routeModifiedSwapStar, loopID > 0 && std::max(routeU->whenLastModified, routeV->whenLastModified) <= lastTestLargeNbRouteU);
+						if (loopID > 0 && std::max(routeU->whenLastModified, routeV->whenLastModified) <= lastTestLargeNbRouteU)
+						{
+							continue;
+						}
 
-					if (!RelocateStar())
-					{
-						if(params->config.skipSwapStarDist || !swapStar(false)){
-							if (params->config.useSwapStarTW)
-							{
-								swapStar(true);
+						LS_STATISTICS_FILTER(circleSectorOverlap, !CircleSector::overlap(routeU->sector, routeV->sector, params->circleSectorOverlapTolerance));
+						if (!CircleSector::overlap(routeU->sector, routeV->sector, params->circleSectorOverlapTolerance))
+						{
+							continue;
+						}
+
+						if (!RelocateStar())
+						{
+							if(params->config.skipSwapStarDist || !swapStar(false)){
+								if (params->config.useSwapStarTW)
+								{
+									swapStar(true);
+								}
 							}
 						}
 					}
@@ -435,6 +472,109 @@ void LocalSearch::run(Individual* indiv, double penaltyCapacityLS, double penalt
 	exportIndividual(indiv);
 }
 
+void LocalSearch::parallelSwapStar()
+{
+	// Collect the route pairs to evaluate, in the same order and with the same filters as the sequential version
+	routePairMoves.clear();
+	for (int rU : orderNonEmptyRoutes)
+	{
+		Route* RU = &routes[rU];
+		int lastTestLargeNbRouteU = RU->whenLastTestedLargeNb;
+		RU->whenLastTestedLargeNb = nbMoves;
+		for (int rV : orderNonEmptyRoutes)
+		{
+			Route* RV = &routes[rV];
+			if (RU->cour >= RV->cour)
+			{
+				continue;
+			}
+
+			LS_STATISTICS_FILTER(routeModifiedSwapStar, loopID > 0 && std::max(RU->whenLastModified, RV->whenLastModified) <= lastTestLargeNbRouteU);
+			if (loopID > 0 && std::max(RU->whenLastModified, RV->whenLastModified) <= lastTestLargeNbRouteU)
+			{
+				continue;
+			}
+
+			LS_STATISTICS_FILTER(circleSectorOverlap, !CircleSector::overlap(RU->sector, RV->sector, params->circleSectorOverlapTolerance));
+			if (!CircleSector::overlap(RU->sector, RV->sector, params->circleSectorOverlapTolerance))
+			{
+				continue;
+			}
+
+			RoutePairMove pairMove;
+			pairMove.routeU = RU;
+			pairMove.routeV = RV;
+			routePairMoves.push_back(pairMove);
+
+			// The removal costs only depend on the route itself and are shared by all pairs, so they are calculated before the threads start
+			for (Route* R : { RU, RV })
+			{
+				if (!params->config.skipSwapStarDist) preprocessRemovals(R, false);
+				if (params->config.useSwapStarTW) preprocessRemovals(R, true);
+			}
+		}
+	}
+
+	// Evaluate the pairs in parallel: thread t evaluates the pairs t, t + nbThreads, ... with its own insertion caches.
+	// The moves only depend on the solution, which is not modified during the evaluation, so they do not depend on the number of threads
+	int nbThreads = std::min(params->config.nbLocalSearchThreads, static_cast<int>(routePairMoves.size()));
+	auto evaluateRange = [&](int threadIdx)
+	{
+		for (int i = threadIdx; i < static_cast<int>(routePairMoves.size()); i += nbThreads)
+		{
+			evaluateRoutePair(routePairMoves[i], threadIdx);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int t = 1; t < nbThreads; t++)
+	{
+		threads.emplace_back(evaluateRange, t);
+	}
+	if (nbThreads > 0) evaluateRange(0);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// Apply the improving moves in the order of the pairs, as long as their routes have not been modified by a previous move
+	// (the other moves are evaluated again in the next SWAP* phase, since their routes have been modified)
+	int nbMovesBefore = nbMoves;
+	for (const RoutePairMove& pairMove : routePairMoves)
+	{
+		if (pairMove.moveCost() > -MY_EPSILON || pairMove.routeU->whenLastModified > nbMovesBefore || pairMove.routeV->whenLastModified > nbMovesBefore)
+		{
+			continue;
+		}
+
+		if (pairMove.isSwapStar) applySwapStar(pairMove.swapStar);
+		else applyRelocateStar(pairMove.relocateStar);
+	}
+}
+
+void LocalSearch::evaluateRoutePair(RoutePairMove& pairMove, int threadIdx)
+{
+	pairMove.isSwapStar = false;
+	pairMove.relocateStar = evaluateRelocateStar(pairMove.routeU, pairMove.routeV, bestInsertClientTW[threadIdx]);
+	if (pairMove.relocateStar.U)
+	{
+		return;
+	}
+
+	pairMove.isSwapStar = true;
+	if (!params->config.skipSwapStarDist)
+	{
+		pairMove.swapStar = evaluateSwapStar(pairMove.routeU, pairMove.routeV, false, bestInsertClient[threadIdx]);
+		if (pairMove.swapStar.moveCost <= -MY_EPSILON)
+		{
+			return;
+		}
+	}
+	if (params->config.useSwapStarTW)
+	{
+		pairMove.swapStar = evaluateSwapStar(pairMove.routeU, pairMove.routeV, true, bestInsertClientTW[threadIdx]);
+	}
+}
+
 void LocalSearch::setLocalVariablesRouteU()
 {
 	routeU = nodeU->route;
@@ -469,6 +609,7 @@ void LocalSearch::setLocalVariablesRouteV()
 
 bool LocalSearch::MoveSingleClient()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::MoveSingleClient);
 	// If U already comes directly after V, this move has no effect
 	if (nodeUIndex == nodeYIndex) return false;
 
@@ -483,8 +624,8 @@ bool LocalSearch::MoveSingleClient()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeX->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prefixTwData, nodeU->twData, nodeY->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getPostfixTwData(nodeX));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getTwData(nodeU), getPostfixTwData(nodeY));
 
 		costSuppU += penaltyExcessLoad(routeU->load - loadU)
 			+ penaltyTimeWindows(routeUTwData)
@@ -506,13 +647,13 @@ bool LocalSearch::MoveSingleClient()
 		{
 			// Edge case V directly after U, so X == V, this works
 			// start - ... - UPrev - X - ... - V - U - Y - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, getRouteSegmentTwData(nodeX, nodeV), nodeU->twData, nodeY->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getRouteSegmentTwData(nodeX, nodeV), getTwData(nodeU), getPostfixTwData(nodeY));
 		}
 		else
 		{
 			// Edge case U directly after V is excluded from beginning of function
 			// start - ... - V - U - Y - ... - UPrev - X - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prefixTwData, nodeU->twData, getRouteSegmentTwData(nodeY, nodeU->prev), nodeX->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getTwData(nodeU), getRouteSegmentTwData(nodeY, nodeU->prev), getPostfixTwData(nodeX));
 		}
 
 		// Compute new total penalty
@@ -524,6 +665,7 @@ bool LocalSearch::MoveSingleClient()
 	if (costSuppU + costSuppV > -MY_EPSILON) return false;
 
 	insertNode(nodeU, nodeV);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -534,6 +676,7 @@ bool LocalSearch::MoveSingleClient()
 
 bool LocalSearch::MoveTwoClients()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::MoveTwoClients);
 	if (nodeU == nodeY || nodeV == nodeX || nodeX->isDepot) return false;
 
 	double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeXNextIndex) - params->timeCost.get(nodeUPrevIndex, nodeUIndex) - params->timeCost.get(nodeXIndex, nodeXNextIndex);
@@ -547,8 +690,8 @@ bool LocalSearch::MoveTwoClients()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeX->next->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prefixTwData, getEdgeTwData(nodeU, nodeX), nodeY->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getPostfixTwData(nodeX->next));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY));
 
 		costSuppU += penaltyExcessLoad(routeU->load - loadU - loadX)
 			+ penaltyTimeWindows(routeUTwData)
@@ -570,13 +713,13 @@ bool LocalSearch::MoveTwoClients()
 		{
 			// Edge case V directly after U, so X == V is excluded, V directly after X so XNext == V works
 			// start - ... - UPrev - XNext - ... - V - U - X - Y - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, getRouteSegmentTwData(nodeX->next, nodeV), getEdgeTwData(nodeU, nodeX), nodeY->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getRouteSegmentTwData(nodeX->next, nodeV), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY));
 		}
 		else
 		{
 			// Edge case U directly after V is excluded from beginning of function
 			// start - ... - V - U - X - Y - ... - UPrev - XNext - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prefixTwData, getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY, nodeU->prev), nodeX->next->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY, nodeU->prev), getPostfixTwData(nodeX->next));
 		}
 
 		// Compute new total penalty
@@ -589,6 +732,7 @@ bool LocalSearch::MoveTwoClients()
 
 	insertNode(nodeU, nodeV);
 	insertNode(nodeX, nodeU);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -599,6 +743,7 @@ bool LocalSearch::MoveTwoClients()
 
 bool LocalSearch::MoveTwoClientsReversed()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::MoveTwoClientsReversed);
 	if (nodeU == nodeY || nodeX == nodeV || nodeX->isDepot) return false;
 
 	double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeXNextIndex) - params->timeCost.get(nodeUPrevIndex, nodeUIndex) - params->timeCost.get(nodeUIndex, nodeXIndex) - params->timeCost.get(nodeXIndex, nodeXNextIndex);
@@ -612,8 +757,8 @@ bool LocalSearch::MoveTwoClientsReversed()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeX->next->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prefixTwData, getEdgeTwData(nodeX, nodeU), nodeY->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getPostfixTwData(nodeX->next));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getEdgeTwData(nodeX, nodeU), getPostfixTwData(nodeY));
 
 		costSuppU += penaltyExcessLoad(routeU->load - loadU - loadX)
 			+ penaltyTimeWindows(routeUTwData)
@@ -635,13 +780,13 @@ bool LocalSearch::MoveTwoClientsReversed()
 		{
 			// Edge case V directly after U, so X == V is excluded, V directly after X so XNext == V works
 			// start - ... - UPrev - XNext - ... - V - X - U - Y - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, getRouteSegmentTwData(nodeX->next, nodeV), getEdgeTwData(nodeX, nodeU), nodeY->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getRouteSegmentTwData(nodeX->next, nodeV), getEdgeTwData(nodeX, nodeU), getPostfixTwData(nodeY));
 		}
 		else
 		{
 			// Edge case U directly after V is excluded from beginning of function
 			// start - ... - V - X - U - Y - ... - UPrev - XNext - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prefixTwData, getEdgeTwData(nodeX, nodeU), getRouteSegmentTwData(nodeY, nodeU->prev), nodeX->next->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getEdgeTwData(nodeX, nodeU), getRouteSegmentTwData(nodeY, nodeU->prev), getPostfixTwData(nodeX->next));
 		}
 
 		// Compute new total penalty
@@ -654,6 +799,7 @@ bool LocalSearch::MoveTwoClientsReversed()
 
 	insertNode(nodeX, nodeV);
 	insertNode(nodeU, nodeX);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -664,6 +810,7 @@ bool LocalSearch::MoveTwoClientsReversed()
 
 bool LocalSearch::SwapTwoSingleClients()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::SwapTwoSingleClients);
 	if (nodeUIndex == nodeVPrevIndex || nodeUIndex == nodeYIndex) return false;
 
 	double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeVIndex) + params->timeCost.get(nodeVIndex, nodeXIndex) - params->timeCost.get(nodeUPrevIndex, nodeUIndex) - params->timeCost.get(nodeUIndex, nodeXIndex);
@@ -677,8 +824,8 @@ bool LocalSearch::SwapTwoSingleClients()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeV->twData, nodeX->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, nodeU->twData, nodeY->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getTwData(nodeV), getPostfixTwData(nodeX));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getTwData(nodeU), getPostfixTwData(nodeY));
 
 		costSuppU += penaltyExcessLoad(routeU->load + loadV - loadU)
 			+ penaltyTimeWindows(routeUTwData)
@@ -700,13 +847,13 @@ bool LocalSearch::SwapTwoSingleClients()
 		{
 			// Edge case V directly after U, so X == V is excluded, V directly after X so XNext == V works
 			// start - ... - UPrev - V - X - ... - VPrev - U - Y - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeV->twData, getRouteSegmentTwData(nodeX, nodeV->prev), nodeU->twData, nodeY->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getTwData(nodeV), getRouteSegmentTwData(nodeX, nodeV->prev), getTwData(nodeU), getPostfixTwData(nodeY));
 		}
 		else
 		{
 			// Edge case U directly after V is excluded from beginning of function
 			// start - ... - VPrev - U - Y - ... - UPrev - V - X - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, nodeU->twData, getRouteSegmentTwData(nodeY, nodeU->prev), nodeV->twData, nodeX->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getTwData(nodeU), getRouteSegmentTwData(nodeY, nodeU->prev), getTwData(nodeV), getPostfixTwData(nodeX));
 		}
 
 		// Compute new total penalty
@@ -718,6 +865,7 @@ bool LocalSearch::SwapTwoSingleClients()
 	if (costSuppU + costSuppV > -MY_EPSILON) return false;
 
 	swapNode(nodeU, nodeV);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -728,6 +876,7 @@ bool LocalSearch::SwapTwoSingleClients()
 
 bool LocalSearch::SwapTwoClientsForOne()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::SwapTwoClientsForOne);
 	if (nodeU == nodeV->prev || nodeX == nodeV->prev || nodeU == nodeY || nodeX->isDepot) return false;
 
 	double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeVIndex) + params->timeCost.get(nodeVIndex, nodeXNextIndex) - params->timeCost.get(nodeUPrevIndex, nodeUIndex) - params->timeCost.get(nodeXIndex, nodeXNextIndex);
@@ -741,8 +890,8 @@ bool LocalSearch::SwapTwoClientsForOne()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeV->twData, nodeX->next->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, getEdgeTwData(nodeU, nodeX), nodeY->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getTwData(nodeV), getPostfixTwData(nodeX->next));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY));
 
 		costSuppU += penaltyExcessLoad(routeU->load + loadV - loadU - loadX)
 			+ penaltyTimeWindows(routeUTwData)
@@ -763,12 +912,12 @@ bool LocalSearch::SwapTwoClientsForOne()
 		if (nodeU->position < nodeV->position)
 		{
 			// start - ... - UPrev - V - XNext - ... - VPrev - U - X - Y - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeV->twData, getRouteSegmentTwData(nodeX->next, nodeV->prev), getEdgeTwData(nodeU, nodeX), nodeY->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getTwData(nodeV), getRouteSegmentTwData(nodeX->next, nodeV->prev), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY));
 		}
 		else
 		{
 			// start - ... - VPrev - U - X - Y - ... - UPrev - V - XNext - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY, nodeU->prev), nodeV->twData, nodeX->next->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY, nodeU->prev), getTwData(nodeV), getPostfixTwData(nodeX->next));
 		}
 
 		// Compute new total penalty
@@ -782,6 +931,7 @@ bool LocalSearch::SwapTwoClientsForOne()
 	// Note: next two lines are a bit inefficient but we only update occasionally and updateRouteData is much more costly anyway, efficient checks are more important
 	swapNode(nodeU, nodeV);
 	insertNode(nodeX, nodeU);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -792,6 +942,7 @@ bool LocalSearch::SwapTwoClientsForOne()
 
 bool LocalSearch::SwapTwoClientPairs()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::SwapTwoClientPairs);
 	if (nodeX->isDepot || nodeY->isDepot || nodeY == nodeU->prev || nodeU == nodeY || nodeX == nodeV || nodeV == nodeX->next) return false;
 
 	double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeVIndex) + params->timeCost.get(nodeYIndex, nodeXNextIndex) - params->timeCost.get(nodeUPrevIndex, nodeUIndex) - params->timeCost.get(nodeXIndex, nodeXNextIndex);
@@ -805,8 +956,8 @@ bool LocalSearch::SwapTwoClientPairs()
 			return false;
 		}
 
-		routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, getEdgeTwData(nodeV, nodeY), nodeX->next->postfixTwData);
-		routeVTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, getEdgeTwData(nodeU, nodeX), nodeY->next->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getEdgeTwData(nodeV, nodeY), getPostfixTwData(nodeX->next));
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY->next));
 
 		costSuppU += penaltyExcessLoad(routeU->load + loadV + loadY - loadU - loadX)
 			+ penaltyTimeWindows(routeUTwData)
@@ -827,12 +978,12 @@ bool LocalSearch::SwapTwoClientPairs()
 		if (nodeU->position < nodeV->position)
 		{
 			// start - ... - UPrev - V - Y - XNext - ... - VPrev - U - X - YNext  - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, getEdgeTwData(nodeV, nodeY), getRouteSegmentTwData(nodeX->next, nodeV->prev), getEdgeTwData(nodeU, nodeX), nodeY->next->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU->prev), getEdgeTwData(nodeV, nodeY), getRouteSegmentTwData(nodeX->next, nodeV->prev), getEdgeTwData(nodeU, nodeX), getPostfixTwData(nodeY->next));
 		}
 		else
 		{
 			// start - ... - VPrev - U - X - YNext - ... - UPrev - V - Y - XNext - ... - end
-			routeUTwData = MergeTWDataRecursive(nodeV->prev->prefixTwData, getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY->next, nodeU->prev), getEdgeTwData(nodeV, nodeY), nodeX->next->postfixTwData);
+			routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeV->prev), getEdgeTwData(nodeU, nodeX), getRouteSegmentTwData(nodeY->next, nodeU->prev), getEdgeTwData(nodeV, nodeY), getPostfixTwData(nodeX->next));
 		}
 
 		// Compute new total penalty
@@ -845,6 +996,7 @@ bool LocalSearch::SwapTwoClientPairs()
 
 	swapNode(nodeU, nodeV);
 	swapNode(nodeX, nodeY);
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -855,6 +1007,7 @@ bool LocalSearch::SwapTwoClientPairs()
 
 bool LocalSearch::TwoOptWithinTrip()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::TwoOptWithinTrip);
 	if (nodeU->position >= nodeV->position - 1) return false;
 
 	double cost = params->timeCost.get(nodeUIndex, nodeVIndex) + params->timeCost.get(nodeXIndex, nodeYIndex) - params->timeCost.get(nodeUIndex, nodeXIndex) - params->timeCost.get(nodeVIndex, nodeYIndex) + nodeV->cumulatedReversalDistance - nodeX->cumulatedReversalDistance;
@@ -864,14 +1017,14 @@ bool LocalSearch::TwoOptWithinTrip()
 		return false;
 	}
 
-	TimeWindowData routeTwData = nodeU->prefixTwData;
+	TimeWindowData routeTwData = getPrefixTwData(nodeU);
 	Node* itRoute = nodeV;
 	while (itRoute != nodeU)
 	{
-		routeTwData = MergeTWDataRecursive(routeTwData, itRoute->twData);
+		routeTwData = MergeTWDataRecursive(routeTwData, getTwData(itRoute));
 		itRoute = itRoute->prev;
 	}
-	routeTwData = MergeTWDataRecursive(routeTwData, nodeY->postfixTwData);
+	routeTwData = MergeTWDataRecursive(routeTwData, getPostfixTwData(nodeY));
 
 	// Compute new total penalty
 	cost += penaltyExcessLoad(routeU->load)
@@ -893,6 +1046,7 @@ bool LocalSearch::TwoOptWithinTrip()
 		insertionPoint = current;
 	}
 
+	LS_STATISTICS_APPLIED(cost);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -902,6 +1056,7 @@ bool LocalSearch::TwoOptWithinTrip()
 
 bool LocalSearch::TwoOptBetweenTrips()
 {
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::TwoOptBetweenTrips);
 	double costSuppU = params->timeCost.get(nodeUIndex, nodeYIndex) - params->timeCost.get(nodeUIndex, nodeXIndex);
 	double costSuppV = params->timeCost.get(nodeVIndex, nodeXIndex) - params->timeCost.get(nodeVIndex, nodeYIndex);
 
@@ -912,8 +1067,8 @@ bool LocalSearch::TwoOptBetweenTrips()
 
 	TimeWindowData routeUTwData, routeVTwData;
 
-	routeUTwData = MergeTWDataRecursive(nodeU->prefixTwData, nodeY->postfixTwData);
-	routeVTwData = MergeTWDataRecursive(nodeV->prefixTwData, nodeX->postfixTwData);
+	routeUTwData = MergeTWDataRecursive(getPrefixTwData(nodeU), getPostfixTwData(nodeY));
+	routeVTwData = MergeTWDataRecursive(getPrefixTwData(nodeV), getPostfixTwData(nodeX));
 
 	costSuppU += penaltyExcessLoad(nodeU->cumulatedLoad + routeV->load - nodeV->cumulatedLoad)
 		+ penaltyTimeWindows(routeUTwData)
@@ -945,6 +1100,7 @@ bool LocalSearch::TwoOptBetweenTrips()
 		insertLocation = current;
 	}
 
+	LS_STATISTICS_APPLIED(costSuppU + costSuppV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
 	updateRouteData(routeU);
@@ -955,71 +1111,67 @@ bool LocalSearch::TwoOptBetweenTrips()
 
 bool LocalSearch::swapStar(const bool withTW)
 {
-	SwapStarElement myBestSwapStar;
-
-	if (!bestInsertInitializedForRoute[routeU->cour])
+	LS_STATISTICS_EVALUATION(withTW ? LocalSearchOperator::SwapStarTW : LocalSearchOperator::SwapStar);
+	preprocessRemovals(routeU, withTW);
+	preprocessRemovals(routeV, withTW);
+	SwapStarElement myBestSwapStar = evaluateSwapStar(routeU, routeV, withTW, withTW ? bestInsertClientTW[0] : bestInsertClient[0]);
+	if (myBestSwapStar.moveCost > -MY_EPSILON)
 	{
-		bestInsertInitializedForRoute[routeU->cour] = true;
-		for (int i = 1; i <= params->nbClients; i++)
-		{
-			bestInsertClient[routeU->cour][i].whenLastCalculated = -1;
-			bestInsertClientTW[routeU->cour][i].whenLastCalculated = -1;
-		}
-	}
-	if (!bestInsertInitializedForRoute[routeV->cour])
-	{
-		bestInsertInitializedForRoute[routeV->cour] = true;
-		for (int i = 1; i <= params->nbClients; i++)
-		{
-			bestInsertClient[routeV->cour][i].whenLastCalculated = -1;
-			bestInsertClientTW[routeV->cour][i].whenLastCalculated = -1;
-		}
+		return false;
 	}
 
+	LS_STATISTICS_APPLIED(myBestSwapStar.moveCost);
+	applySwapStar(myBestSwapStar);
+	return true;
+}
+
+SwapStarElement LocalSearch::evaluateSwapStar(Route* RU, Route* RV, const bool withTW, ThreeBestInsertCache& cache)
+{
+	SwapStarElement myBestSwapStar;
+
 	// Preprocessing insertion costs
 	if (withTW)
 	{
-		preprocessInsertionsWithTW(routeU, routeV);
-		preprocessInsertionsWithTW(routeV, routeU);
+		preprocessInsertionsWithTW(RU, RV, cache);
+		preprocessInsertionsWithTW(RV, RU, cache);
 	}
 	else
 	{
-		preprocessInsertions(routeU, routeV);
-		preprocessInsertions(routeV, routeU);
+		preprocessInsertions(RU, RV, cache);
+		preprocessInsertions(RV, RU, cache);
 	}
-	
 
 	// Evaluating the moves
-	for (nodeU = routeU->depot->next; !nodeU->isDepot; nodeU = nodeU->next)
+	for (Node* U = RU->depot->next; !U->isDepot; U = U->next)
 	{
-		for (nodeV = routeV->depot->next; !nodeV->isDepot; nodeV = nodeV->next)
+		for (Node* V = RV->depot->next; !V->isDepot; V = V->next)
 		{
 			// We cannot determine impact on timewarp without adding too much complexity (O(n^3) instead of O(n^2))
-			const double loadPenU = penaltyExcessLoad(routeU->load + params->cli[nodeV->cour].demand - params->cli[nodeU->cour].demand);
-			const double loadPenV = penaltyExcessLoad(routeV->load + params->cli[nodeU->cour].demand - params->cli[nodeV->cour].demand);
-			const double deltaLoadPen = loadPenU + loadPenV - penaltyExcessLoad(routeU->load) - penaltyExcessLoad(routeV->load);
-			const int deltaRemoval = withTW ? nodeU->deltaRemovalTW + nodeV->deltaRemovalTW : nodeU->deltaRemoval + nodeV->deltaRemoval;
+			const double loadPenU = penaltyExcessLoad(RU->load + params->cli[V->cour].demand - params->cli[U->cour].demand);
+			const double loadPenV = penaltyExcessLoad(RV->load + params->cli[U->cour].demand - params->cli[V->cour].demand);
+			const double deltaLoadPen = loadPenU + loadPenV - penaltyExcessLoad(RU->load) - penaltyExcessLoad(RV->load);
+			const int deltaRemoval = withTW ? U->deltaRemovalTW + V->deltaRemovalTW : U->deltaRemoval + V->deltaRemoval;
 
 			// Quick filter: possibly early elimination of many SWAP* due to the capacity constraints/penalties and bounds on insertion costs
 			if (deltaLoadPen + deltaRemoval <= 0)
 			{
 				SwapStarElement mySwapStar;
-				mySwapStar.U = nodeU;
-				mySwapStar.V = nodeV;
+				mySwapStar.U = U;
+				mySwapStar.V = V;
 
 				int extraV, extraU;
 				if (withTW){
 					// Evaluate best reinsertion cost of U in the route of V where V has been removed
-					extraV = getCheapestInsertSimultRemovalWithTW(nodeU, nodeV, mySwapStar.bestPositionU);
+					extraV = getCheapestInsertSimultRemovalWithTW(U, V, mySwapStar.bestPositionU, cache);
 
 					// Evaluate best reinsertion cost of V in the route of U where U has been removed
-					extraU = getCheapestInsertSimultRemovalWithTW(nodeV, nodeU, mySwapStar.bestPositionV);
+					extraU = getCheapestInsertSimultRemovalWithTW(V, U, mySwapStar.bestPositionV, cache);
 				} else {
 					// Evaluate best reinsertion cost of U in the route of V where V has been removed
-					extraV = getCheapestInsertSimultRemoval(nodeU, nodeV, mySwapStar.bestPositionU);
+					extraV = getCheapestInsertSimultRemoval(U, V, mySwapStar.bestPositionU, cache);
 
 					// Evaluate best reinsertion cost of V in the route of U where U has been removed
-					extraU = getCheapestInsertSimultRemoval(nodeV, nodeU, mySwapStar.bestPositionV);
+					extraU = getCheapestInsertSimultRemoval(V, U, mySwapStar.bestPositionV, cache);
 				}
 
 				// Evaluating final cost
@@ -1037,7 +1189,8 @@ bool LocalSearch::swapStar(const bool withTW)
 
 	if (!myBestSwapStar.bestPositionU || !myBestSwapStar.bestPositionV)
 	{
-		return false;
+		myBestSwapStar.moveCost = 1.e30;
+		return myBestSwapStar;
 	}
 
 	// Compute actual cost including TimeWarp penalty
@@ -1077,116 +1230,138 @@ bool LocalSearch::swapStar(const bool withTW)
 	if (myBestSwapStar.bestPositionV->position == myBestSwapStar.U->position - 1)
 	{
 		// Special case
-		routeUTwData = MergeTWDataRecursive(myBestSwapStar.bestPositionV->prefixTwData, myBestSwapStar.V->twData, myBestSwapStar.U->next->postfixTwData);
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.bestPositionV), getTwData(myBestSwapStar.V), getPostfixTwData(myBestSwapStar.U->next));
 	}
 	else if (myBestSwapStar.bestPositionV->position < myBestSwapStar.U->position)
 	{
-		routeUTwData = MergeTWDataRecursive(myBestSwapStar.bestPositionV->prefixTwData,
-			myBestSwapStar.V->twData,
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.bestPositionV),
+			getTwData(myBestSwapStar.V),
 			getRouteSegmentTwData(myBestSwapStar.bestPositionV->next, myBestSwapStar.U->prev),
-			myBestSwapStar.U->next->postfixTwData);
+			getPostfixTwData(myBestSwapStar.U->next));
 	}
 	else
 	{
-		routeUTwData = MergeTWDataRecursive(myBestSwapStar.U->prev->prefixTwData,
+		routeUTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.U->prev),
 			getRouteSegmentTwData(myBestSwapStar.U->next, myBestSwapStar.bestPositionV),
-			myBestSwapStar.V->twData,
-			myBestSwapStar.bestPositionV->next->postfixTwData);
+			getTwData(myBestSwapStar.V),
+			getPostfixTwData(myBestSwapStar.bestPositionV->next));
 	}
 
 	if (myBestSwapStar.bestPositionU->position == myBestSwapStar.V->position - 1)
 	{
 		// Special case
-		routeVTwData = MergeTWDataRecursive(myBestSwapStar.bestPositionU->prefixTwData, myBestSwapStar.U->twData, myBestSwapStar.V->next->postfixTwData);
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.bestPositionU), getTwData(myBestSwapStar.U), getPostfixTwData(myBestSwapStar.V->next));
 	}
 	else if (myBestSwapStar.bestPositionU->position < myBestSwapStar.V->position)
 	{
-		routeVTwData = MergeTWDataRecursive(myBestSwapStar.bestPositionU->prefixTwData,
-			myBestSwapStar.U->twData,
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.bestPositionU),
+			getTwData(myBestSwapStar.U),
 			getRouteSegmentTwData(myBestSwapStar.bestPositionU->next, myBestSwapStar.V->prev),
-			myBestSwapStar.V->next->postfixTwData);
+			getPostfixTwData(myBestSwapStar.V->next));
 	}
 	else
 	{
-		routeVTwData = MergeTWDataRecursive(myBestSwapStar.V->prev->prefixTwData,
+		routeVTwData = MergeTWDataRecursive(getPrefixTwData(myBestSwapStar.V->prev),
 			getRouteSegmentTwData(myBestSwapStar.V->next, myBestSwapStar.bestPositionU),
-			myBestSwapStar.U->twData,
-			myBestSwapStar.bestPositionU->next->postfixTwData);
+			getTwData(myBestSwapStar.U),
+			getPostfixTwData(myBestSwapStar.bestPositionU->next));
 	}
 
-	costSuppU += myBestSwapStar.loadPenU + penaltyTimeWindows(routeUTwData) - routeU->penalty;
+	costSuppU += myBestSwapStar.loadPenU + penaltyTimeWindows(routeUTwData) - RU->penalty;
 
-	costSuppV += myBestSwapStar.loadPenV + penaltyTimeWindows(routeVTwData) - routeV->penalty;
+	costSuppV += myBestSwapStar.loadPenV + penaltyTimeWindows(routeVTwData) - RV->penalty;
 
-	if (costSuppU + costSuppV > -MY_EPSILON)
-	{
-		return false;
-	}
+	// The estimated cost used to select the move is replaced by its actual cost
+	myBestSwapStar.moveCost = costSuppU + costSuppV;
+	return myBestSwapStar;
+}
 
-	// Applying the best move in case of improvement
-	insertNode(myBestSwapStar.U, myBestSwapStar.bestPositionU);
-	insertNode(myBestSwapStar.V, myBestSwapStar.bestPositionV);
+void LocalSearch::applySwapStar(const SwapStarElement& move)
+{
+	Route* RU = move.U->route;
+	Route* RV = move.V->route;
+	insertNode(move.U, move.bestPositionU);
+	insertNode(move.V, move.bestPositionV);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
-	updateRouteData(routeU);
-	updateRouteData(routeV);
+	updateRouteData(RU);
+	updateRouteData(RV);
+}
+
+bool LocalSearch::RelocateStar()
+{
+	LS_STATISTICS_EVALUATION(LocalSearchOperator::RelocateStar);
+	RelocateStarElement bestRelocateStar = evaluateRelocateStar(routeU, routeV, bestInsertClientTW[0]);
+	if (!bestRelocateStar.U)
+	{
+		return false;
+	}
 
+	LS_STATISTICS_APPLIED(bestRelocateStar.moveCost);
+	applyRelocateStar(bestRelocateStar);
 	return true;
 }
 
-bool LocalSearch::RelocateStar()
+RelocateStarElement LocalSearch::evaluateRelocateStar(Route* RU, Route* RV, ThreeBestInsertCache& cacheTW)
 {
-	double bestCost = 0;
-	Node* insertionPoint = nullptr;
-	Node* nodeToInsert = nullptr;
-	for (nodeU = routeU->depot->next; !nodeU->isDepot; nodeU = nodeU->next)
-	{
-		setLocalVariablesRouteU();
-
-		const TimeWindowData routeUTwData = MergeTWDataRecursive(nodeU->prev->prefixTwData, nodeX->postfixTwData);
-		const double costSuppU = params->timeCost.get(nodeUPrevIndex, nodeXIndex)
-			- params->timeCost.get(nodeUPrevIndex, nodeUIndex)
-			- params->timeCost.get(nodeUIndex, nodeXIndex)
-			+ penaltyExcessLoad(routeU->load - loadU)
+	// The cheapest insertions (including time windows) of the clients of RU in RV are shared with SWAP*, and only calculated if RV changed
+	preprocessInsertionsWithTW(RU, RV, cacheTW);
+
+	RelocateStarElement bestRelocateStar;
+	bestRelocateStar.moveCost = 0;
+	for (Node* U = RU->depot->next; !U->isDepot; U = U->next)
+	{
+		const int indexU = U->cour;
+		const int indexUPrev = U->prev->cour;
+		const int indexX = U->next->cour;
+		const int loadU = params->cli[indexU].demand;
+
+		const TimeWindowData routeUTwData = MergeTWDataRecursive(getPrefixTwData(U->prev), getPostfixTwData(U->next));
+		const double costSuppU = params->timeCost.get(indexUPrev, indexX)
+			- params->timeCost.get(indexUPrev, indexU)
+			- params->timeCost.get(indexU, indexX)
+			+ penaltyExcessLoad(RU->load - loadU)
 			+ penaltyTimeWindows(routeUTwData)
-			- routeU->penalty;
-
-		for (Node* V = routeV->depot->next; !V->isDepot; V = V->next)
+			- RU->penalty;
+
+		// The insertion positions are ranked with integer costs, so the cost of the best one is calculated again exactly.
+		// The time window penalty is not negative, so the move is discarded before merging the time window data if the other terms are not improving
+		Node* V = cacheTW.get(indexU, RV, routes).bestLocation[0];
+		double costSuppV = params->timeCost.get(V->cour, indexU)
+			+ params->timeCost.get(indexU, V->next->cour)
+			- params->timeCost.get(V->cour, V->next->cour)
+			+ penaltyExcessLoad(RV->load + loadU)
+			- RV->penalty;
+		if (costSuppU + costSuppV >= bestRelocateStar.moveCost - MY_EPSILON)
 		{
-			const TimeWindowData routeVTwData = MergeTWDataRecursive(V->prefixTwData, nodeU->twData, V->next->postfixTwData);
-			double costSuppV = params->timeCost.get(V->cour, nodeUIndex)
-				+ params->timeCost.get(nodeUIndex, V->next->cour)
-				- params->timeCost.get(V->cour, V->next->cour)
-				+ penaltyExcessLoad(routeV->load + loadU)
-				+ penaltyTimeWindows(routeVTwData)
-				- routeV->penalty;
-			if (costSuppU + costSuppV < bestCost - MY_EPSILON)
-			{
-				bestCost = costSuppU + costSuppV;
-				insertionPoint = V;
-				nodeToInsert = nodeU;
-			}
+			continue;
 		}
-	}
 
-	if (!insertionPoint)
-	{
-		return false;
+		const TimeWindowData routeVTwData = MergeTWDataRecursive(getPrefixTwData(V), getTwData(U), getPostfixTwData(V->next));
+		costSuppV += penaltyTimeWindows(routeVTwData);
+		if (costSuppU + costSuppV < bestRelocateStar.moveCost - MY_EPSILON)
+		{
+			bestRelocateStar.moveCost = costSuppU + costSuppV;
+			bestRelocateStar.U = U;
+			bestRelocateStar.bestPositionU = V;
+		}
 	}
+	return bestRelocateStar;
+}
 
-	routeU = nodeToInsert->route;
-	insertNode(nodeToInsert, insertionPoint);
+void LocalSearch::applyRelocateStar(const RelocateStarElement& move)
+{
+	Route* RU = move.U->route;
+	insertNode(move.U, move.bestPositionU);
 	nbMoves++; // Increment move counter before updating route data
 	searchCompleted = false;
-	updateRouteData(routeU);
-	updateRouteData(insertionPoint->route);
-
-	return true;
+	updateRouteData(RU);
+	updateRouteData(move.bestPositionU->route);
 }
 
-int LocalSearch::getCheapestInsertSimultRemoval(Node* U, Node* V, Node*& bestPosition)
+int LocalSearch::getCheapestInsertSimultRemoval(Node* U, Node* V, Node*& bestPosition, ThreeBestInsertCache& cache)
 {
-	ThreeBestInsert* myBestInsert = &bestInsertClient[V->route->cour][U->cour];
+	ThreeBestInsert* myBestInsert = &cache.get(U->cour, V->route, routes);
 	bool found = false;
 
 	// Find best insertion in the route such that V is not next or pred (can only belong to the top three locations)
@@ -1218,10 +1393,10 @@ int LocalSearch::getCheapestInsertSimultRemoval(Node* U, Node* V, Node*& bestPos
 }
 
 // TODO make this double as cost??
-int LocalSearch::getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& bestPosition)
+int LocalSearch::getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& bestPosition, ThreeBestInsertCache& cache)
 {
 	// TODO ThreeBestInsert must also use double as cost?
-	ThreeBestInsert* myBestInsert = &bestInsertClientTW[V->route->cour][U->cour];
+	ThreeBestInsert* myBestInsert = &cache.get(U->cour, V->route, routes);
 	bool found = false;
 
 	// Find best insertion in the route such that V is not next or pred (can only belong to the top three locations)
@@ -1242,7 +1417,7 @@ int LocalSearch::getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& b
 	}
 
 	// Compute insertion in the place of V
-	TimeWindowData twData = MergeTWDataRecursive(V->prev->prefixTwData, U->twData, V->next->postfixTwData);
+	TimeWindowData twData = MergeTWDataRecursive(getPrefixTwData(V->prev), getTwData(U), getPostfixTwData(V->next));
 	int deltaCost = params->timeCost.get(V->prev->cour, U->cour) + params->timeCost.get(U->cour, V->next->cour) - params->timeCost.get(V->prev->cour, V->next->cour) + deltaPenaltyTimeWindows(twData, V->route->twData);
 	if (!found || deltaCost < bestCost)
 	{
@@ -1253,13 +1428,34 @@ int LocalSearch::getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& b
 	return bestCost;
 }
 
-void LocalSearch::preprocessInsertions(Route* R1, Route* R2)
+void LocalSearch::preprocessRemovals(Route* R1, const bool withTW)
+{
+	if (!withTW)
+	{
+		for (Node* U = R1->depot->next; !U->isDepot; U = U->next)
+		{
+			U->deltaRemoval = params->timeCost.get(U->prev->cour, U->next->cour) - params->timeCost.get(U->prev->cour, U->cour) - params->timeCost.get(U->cour, U->next->cour);
+		}
+	}
+	else if (R1->isDeltaRemovalTWOutdated)
+	{
+		// Note: when removing U and adding V to a route, the timewarp penalties may interact, however in most cases it will hold that
+		// the reduced timewarp from removing U + added timewarp from adding V will be bigger than the actual delta timewarp such that assuming independence gives a conservative estimate
+		for (Node* U = R1->depot->next; !U->isDepot; U = U->next)
+		{
+			TimeWindowData twData = MergeTWDataRecursive(getPrefixTwData(U->prev), getPostfixTwData(U->next));
+			U->deltaRemovalTW = params->timeCost.get(U->prev->cour, U->next->cour) - params->timeCost.get(U->prev->cour, U->cour) - params->timeCost.get(U->cour, U->next->cour) + deltaPenaltyTimeWindows(twData, R1->twData);
+		}
+		R1->isDeltaRemovalTWOutdated = false;
+	}
+}
+
+void LocalSearch::preprocessInsertions(Route* R1, Route* R2, ThreeBestInsertCache& cache)
 {
 	for (Node* U = R1->depot->next; !U->isDepot; U = U->next)
 	{
 		// Performs the preprocessing
-		U->deltaRemoval = params->timeCost.get(U->prev->cour, U->next->cour) - params->timeCost.get(U->prev->cour, U->cour) - params->timeCost.get(U->cour, U->next->cour);
-		auto& currentOption = bestInsertClient[R2->cour][U->cour];
+		auto& currentOption = cache.get(U->cour, R2, routes);
 		if (R2->whenLastModified > currentOption.whenLastCalculated)
 		{
 			currentOption.reset();
@@ -1275,77 +1471,137 @@ void LocalSearch::preprocessInsertions(Route* R1, Route* R2)
 	}
 }
 
-void LocalSearch::preprocessInsertionsWithTW(Route* R1, Route* R2)
+void LocalSearch::preprocessInsertionsWithTW(Route* R1, Route* R2, ThreeBestInsertCache& cache)
 {
 	TimeWindowData twData;
 	for (Node* U = R1->depot->next; !U->isDepot; U = U->next)
 	{
 		// Performs the preprocessing
-		// Note: when removing U and adding V to a route, the timewarp penalties may interact, however in most cases it will hold that
-		// the reduced timewarp from removing U + added timewarp from adding V will be bigger than the actual delta timewarp such that assuming independence gives a conservative estimate
-		
-		if (R1->isDeltaRemovalTWOutdated)
-		{
-			twData = MergeTWDataRecursive(U->prev->prefixTwData, U->next->postfixTwData);
-			U->deltaRemovalTW = params->timeCost.get(U->prev->cour, U->next->cour) - params->timeCost.get(U->prev->cour, U->cour) - params->timeCost.get(U->cour, U->next->cour) + deltaPenaltyTimeWindows(twData, R1->twData);
-		}
-		auto& currentOption = bestInsertClientTW[R2->cour][U->cour];
+		auto& currentOption = cache.get(U->cour, R2, routes);
 		if (R2->whenLastModified > currentOption.whenLastCalculated)
 		{
 			currentOption.reset();
 			currentOption.whenLastCalculated = nbMoves;
 
 			// Compute additional timewarp we get when inserting U in R2, this may be actually less if we remove U but we ignore this to have a conservative estimate
-			twData = MergeTWDataRecursive(R2->depot->prefixTwData, U->twData, R2->depot->next->postfixTwData);
+			twData = MergeTWDataRecursive(getPrefixTwData(R2->depot), getTwData(U), getPostfixTwData(R2->depot->next));
 			
 			currentOption.bestCost[0] = params->timeCost.get(0, U->cour) + params->timeCost.get(U->cour, R2->depot->next->cour) - params->timeCost.get(0, R2->depot->next->cour) + deltaPenaltyTimeWindows(twData, R2->twData);
 
 			currentOption.bestLocation[0] = R2->depot;
 			for (Node* V = R2->depot->next; !V->isDepot; V = V->next)
 			{
-				twData = MergeTWDataRecursive(V->prefixTwData, U->twData, V->next->postfixTwData);
+				twData = MergeTWDataRecursive(getPrefixTwData(V), getTwData(U), getPostfixTwData(V->next));
 				int deltaCost = params->timeCost.get(V->cour, U->cour) + params->timeCost.get(U->cour, V->next->cour) - params->timeCost.get(V->cour, V->next->cour) + deltaPenaltyTimeWindows(twData, R2->twData);
 				currentOption.compareAndAdd(deltaCost, V);
 			}
 		}
 	}
-	R1->isDeltaRemovalTWOutdated = false;
 }
 
 TimeWindowData LocalSearch::getEdgeTwData(Node* U, Node* V)
 {
-	// TODO this could be cached?
-	return MergeTWDataRecursive(U->twData, V->twData);
+	// The moves only ask for the edges between a node and its successor (in both directions), which are cached by updateRouteData
+	if (U->next == V)
+		return getEdgeCache(U).toNextTwData;
+	if (V->next == U)
+		return getEdgeCache(V).fromNextTwData;
+	return MergeTWDataRecursive(getTwData(U), getTwData(V));
 }
 
 TimeWindowData LocalSearch::getRouteSegmentTwData(Node* U, Node* V)
 {
 	if (U->isDepot)
-		return V->prefixTwData;
+		return getPrefixTwData(V);
 	if (V->isDepot)
-		return U->postfixTwData;
+		return getPostfixTwData(U);
+
+	if (params->config.useRouteSegmentTree)
+		return getRouteSegmentTwDataFromTree(U->route, U->position, V->position);
 
 	// Struct so this makes a copy
-	TimeWindowData twData = U->twData;
+	TimeWindowData twData = getTwData(U);
 
 	Node* mynode = U;
 	const int targetPos = V->position;
 	while (!(mynode == V))
 	{
-		if (mynode->isSeed && mynode->position + 4 <= targetPos)
+		if (getSeedData(mynode).isSeed && mynode->position + 4 <= targetPos)
 		{
-			twData = MergeTWDataRecursive(twData, mynode->toNextSeedTwD);
-			mynode = mynode->nextSeed;
+			twData = MergeTWDataRecursive(twData, getSeedData(mynode).toNextSeedTwD);
+			mynode = getSeedData(mynode).nextSeed;
 		}
 		else
 		{
 			mynode = mynode->next;
-			twData = MergeTWDataRecursive(twData, mynode->twData);
+			twData = MergeTWDataRecursive(twData, getTwData(mynode));
 		}
 	}
 	return twData;
 }
 
+void LocalSearch::updateRouteSegmentTree(Route* myRoute, Node* firstNode)
+{
+	// The leaves (from index capacity onwards) contain the time window data of the nodes by position, and internal node i merges nodes 2i and 2i + 1.
+	// Leaves after the end of the route may contain outdated data, but the internal nodes that contain them are never used in a query
+	std::vector<TimeWindowData>& tree = routeSegmentTrees[myRoute->cour];
+	int nbPositions = myRoute->nbCustomers + 2;
+	int capacity = static_cast<int>(tree.size()) / 2;
+	if (capacity < nbPositions)
+	{
+		capacity = static_cast<int>(std::bit_ceil(static_cast<unsigned int>(nbPositions)));
+		tree.assign(2 * capacity, TimeWindowData());
+		firstNode = myRoute->depot;
+	}
+
+	// Leaves of the nodes from firstNode onwards (the nodes before firstNode did not change)
+	int firstPosition = firstNode->position;
+	Node* mynode = firstNode;
+	for (int pos = firstPosition; pos < nbPositions; pos++)
+	{
+		tree[capacity + pos] = getTwData(mynode);
+		mynode = mynode->next;
+	}
+
+	// Internal nodes above these leaves
+	for (int first = (capacity + firstPosition) / 2, last = (capacity + nbPositions - 1) / 2; first >= 1; first /= 2, last /= 2)
+	{
+		for (int i = first; i <= last; i++)
+		{
+			tree[i] = MergeTWDataRecursive(tree[2 * i], tree[2 * i + 1]);
+		}
+	}
+}
+
+TimeWindowData LocalSearch::getRouteSegmentTwDataFromTree(Route* myRoute, int firstPosition, int lastPosition)
+{
+	// Bottom-up query, merging the nodes at the left side of the segment in leftTwData and at the right side in rightTwData
+	const std::vector<TimeWindowData>& tree = routeSegmentTrees[myRoute->cour];
+	int capacity = static_cast<int>(tree.size()) / 2;
+	TimeWindowData leftTwData;
+	TimeWindowData rightTwData;
+	bool hasLeft = false;
+	bool hasRight = false;
+	for (int left = capacity + firstPosition, right = capacity + lastPosition + 1; left < right; left /= 2, right /= 2)
+	{
+		if (left & 1)
+		{
+			leftTwData = hasLeft ? MergeTWDataRecursive(leftTwData, tree[left]) : tree[left];
+			hasLeft = true;
+			left++;
+		}
+		if (right & 1)
+		{
+			right--;
+			rightTwData = hasRight ? MergeTWDataRecursive(tree[right], rightTwData) : tree[right];
+			hasRight = true;
+		}
+	}
+	if (!hasLeft) return rightTwData;
+	if (!hasRight) return leftTwData;
+	return MergeTWDataRecursive(leftTwData, rightTwData);
+}
+
 TimeWindowData LocalSearch::MergeTWDataRecursive(const TimeWindowData& twData1, const TimeWindowData& twData2)
 {
 	TimeWindowData mergedTwData;
@@ -1367,6 +1623,8 @@ TimeWindowData LocalSearch::MergeTWDataRecursive(const TimeWindowData& twData1,
 
 void LocalSearch::insertNode(Node* toInsert, Node* insertionPoint)
 {
+	setRouteModified(toInsert->route, toInsert->position, toInsert->position);
+	setRouteModified(insertionPoint->route, insertionPoint->position + 1, insertionPoint->position);
 	toInsert->prev->next = toInsert->next;
 	toInsert->next->prev = toInsert->prev;
 	insertionPoint->next->prev = toInsert;
@@ -1384,6 +1642,8 @@ void LocalSearch::swapNode(Node* U, Node* V)
 	Node* myUSuiv = U->next;
 	Route* myRouteU = U->route;
 	Route* myRouteV = V->route;
+	setRouteModified(myRouteU, U->position, U->position);
+	setRouteModified(myRouteV, V->position, V->position);
 
 	myUPred->next = V;
 	myUSuiv->prev = V;
@@ -1401,22 +1661,64 @@ void LocalSearch::swapNode(Node* U, Node* V)
 
 void LocalSearch::updateRouteData(Route* myRoute)
 {
+	// Only the data of the modified part of the route is recomputed: the forward data (positions, cumulated values, prefixes, seeds, sector)
+	// from the first modified position, and the postfixes up to the last modified position (see setRouteModified)
+	int nbCustomersBefore = myRoute->nbCustomers;
+	if (params->config.useDontLookBits)
+	{
+		// The RI moves of all clients of a modified route are evaluated again
+		for (Node* node = myRoute->depot->next; !node->isDepot; node = node->next) isNodeActive[node->cour] = true;
+	}
+	int firstModifiedPosition = std::max(myRoute->firstModifiedPosition, 1);
+	int lastModifiedPosition = myRoute->lastModifiedPosition;
+	myRoute->firstModifiedPosition = INT_MAX;
+	myRoute->lastModifiedPosition = INT_MIN;
+
+	// Restart from the last seed position before the first modified position, since the seeds cover the next four nodes
+	int restartPosition = 4 * ((firstModifiedPosition - 1) / 4);
 	int myplace = 0;
+	Node* mynode = myRoute->depot;
+	while (myplace < restartPosition && !mynode->next->isDepot)
+	{
+		mynode = mynode->next;
+		myplace++;
+	}
+	if (myplace < restartPosition)
+	{
+		// The route is shorter than expected, recompute it completely
+		mynode = myRoute->depot;
+		myplace = 0;
+	}
+
 	int myload = 0;
 	int mytime = 0;
 	int myReversalDistance = 0;
 	int cumulatedX = 0;
 	int cumulatedY = 0;
-
-	Node* mynode = myRoute->depot;
-	mynode->position = 0;
-	mynode->cumulatedLoad = 0;
-	mynode->cumulatedTime = 0;
-	mynode->cumulatedReversalDistance = 0;
-
-	bool firstIt = true;
 	TimeWindowData seedTwD;
 	Node* seedNode = nullptr;
+	if (mynode->isDepot)
+	{
+		mynode->position = 0;
+		mynode->cumulatedLoad = 0;
+		mynode->cumulatedTime = 0;
+		mynode->cumulatedReversalDistance = 0;
+	}
+	else
+	{
+		myload = mynode->cumulatedLoad;
+		mytime = mynode->cumulatedTime;
+		myReversalDistance = mynode->cumulatedReversalDistance;
+		cumulatedX = getCumulatedData(mynode).cumulatedX;
+		cumulatedY = getCumulatedData(mynode).cumulatedY;
+		myRoute->sector = getCumulatedData(mynode).sector;
+		getSeedData(mynode).isSeed = false;
+		getSeedData(mynode).nextSeed = nullptr;
+		seedNode = mynode;
+	}
+
+	Node* restartNode = mynode;
+	bool firstIt = true;
 	while (!mynode->isDepot || firstIt)
 	{
 		mynode = mynode->next;
@@ -1428,32 +1730,39 @@ void LocalSearch::updateRouteData(Route* myRoute)
 		mynode->cumulatedLoad = myload;
 		mynode->cumulatedTime = mytime;
 		mynode->cumulatedReversalDistance = myReversalDistance;
-		mynode->prefixTwData = MergeTWDataRecursive(mynode->prev->prefixTwData, mynode->twData);
-		mynode->isSeed = false;
-		mynode->nextSeed = nullptr;
+		getPrefixTwData(mynode) = MergeTWDataRecursive(getPrefixTwData(mynode->prev), getTwData(mynode));
+		getEdgeCache(mynode->prev).toNextTwData = MergeTWDataRecursive(getTwData(mynode->prev), getTwData(mynode));
+		getEdgeCache(mynode->prev).fromNextTwData = MergeTWDataRecursive(getTwData(mynode), getTwData(mynode->prev));
+		getSeedData(mynode).isSeed = false;
+		getSeedData(mynode).nextSeed = nullptr;
 		if (!mynode->isDepot)
 		{
 			cumulatedX += params->cli[mynode->cour].coordX;
 			cumulatedY += params->cli[mynode->cour].coordY;
-			if (firstIt) myRoute->sector.initialize(params->cli[mynode->cour].polarAngle);
+			if (myplace == 1) myRoute->sector.initialize(params->cli[mynode->cour].polarAngle);
 			else myRoute->sector.extend(params->cli[mynode->cour].polarAngle);
-			if (myplace % 4 == 0)
+			getCumulatedData(mynode) = { cumulatedX, cumulatedY, myRoute->sector };
+			if (params->config.useRouteSegmentTree)
+			{
+				// The seeds are not used
+			}
+			else if (myplace % 4 == 0)
 			{
 				if (seedNode != nullptr)
 				{
-					seedNode->isSeed = true;
-					seedNode->toNextSeedTwD = MergeTWDataRecursive(seedTwD, mynode->twData);
-					seedNode->nextSeed = mynode;
+					getSeedData(seedNode).isSeed = true;
+					getSeedData(seedNode).toNextSeedTwD = MergeTWDataRecursive(seedTwD, getTwData(mynode));
+					getSeedData(seedNode).nextSeed = mynode;
 				}
 				seedNode = mynode;
 			}
 			else if (myplace % 4 == 1)
 			{
-				seedTwD = mynode->twData;
+				seedTwD = getTwData(mynode);
 			}
 			else
 			{
-				seedTwD = MergeTWDataRecursive(seedTwD, mynode->twData);
+				seedTwD = MergeTWDataRecursive(seedTwD, getTwData(mynode));
 			}
 		}
 		firstIt = false;
@@ -1461,21 +1770,28 @@ void LocalSearch::updateRouteData(Route* myRoute)
 
 	myRoute->duration = mytime; // Driving duration + service duration, excluding waiting time / time warp
 	myRoute->load = myload;
-	myRoute->twData = mynode->prefixTwData;
+	myRoute->twData = getPrefixTwData(mynode);
 	myRoute->penalty = penaltyExcessLoad(myload) + penaltyTimeWindows(myRoute->twData);
 	myRoute->nbCustomers = myplace - 1;
 	myRoute->reversalDistance = myReversalDistance;
 	// Remember "when" this route has been last modified (will be used to filter unnecessary move evaluations)
 	myRoute->whenLastModified = nbMoves;
 	myRoute->isDeltaRemovalTWOutdated = true;
+	if (params->config.useRouteSegmentTree)
+	{
+		updateRouteSegmentTree(myRoute, restartNode);
+	}
 
-	// Time window data in reverse direction, mynode should be end depot now
-	firstIt = true;
-	while (!mynode->isDepot || firstIt)
+	// Time window data in reverse direction, mynode should be end depot now. The postfixes of the nodes after the last modified position did not change
+	int nbUnmodifiedAtEnd = std::max(nbCustomersBefore + 1 - std::max(lastModifiedPosition, 0), 1);
+	for (int i = 1; i < nbUnmodifiedAtEnd && !mynode->prev->isDepot; i++)
 	{
 		mynode = mynode->prev;
-		mynode->postfixTwData = MergeTWDataRecursive(mynode->twData, mynode->next->postfixTwData);
-		firstIt = false;
+	}
+	while (mynode != myRoute->depot)
+	{
+		mynode = mynode->prev;
+		getPostfixTwData(mynode) = MergeTWDataRecursive(getTwData(mynode), getPostfixTwData(mynode->next));
 	}
 
 	if (myRoute->nbCustomers == 0)
@@ -1547,7 +1863,7 @@ void LocalSearch::loadIndividual(Individual* indiv)
 	// Initializing time window data (before loop since it is needed in update route)
 	for (int i = 1; i <= params->nbClients; i++)
 	{
-		TimeWindowData* myTwData = &clients[i].twData;
+		TimeWindowData* myTwData = &getTwData(&clients[i]);
 		myTwData->firstNodeIndex = i;
 		myTwData->lastNodeIndex = i;
 		myTwData->duration = params->cli[i].serviceDuration;
@@ -1587,19 +1903,26 @@ void LocalSearch::loadIndividual(Individual* indiv)
 			myDepotFin->prev = myDepot;
 		}
 
-		myDepot->twData = depotTwData;
-		myDepot->prefixTwData = depotTwData;
-		myDepot->postfixTwData = depotTwData;
-		myDepot->isSeed = false;
+		getTwData(myDepot) = depotTwData;
+		getPrefixTwData(myDepot) = depotTwData;
+		getPostfixTwData(myDepot) = depotTwData;
+		getSeedData(myDepot).isSeed = false;
 
-		myDepotFin->twData = depotTwData;
-		myDepotFin->prefixTwData = depotTwData;
-		myDepotFin->postfixTwData = depotTwData;
-		myDepotFin->isSeed = false;
+		getTwData(myDepotFin) = depotTwData;
+		getPrefixTwData(myDepotFin) = depotTwData;
+		getPostfixTwData(myDepotFin) = depotTwData;
+		getSeedData(myDepotFin).isSeed = false;
 
+		setRouteModified(&routes[r]);
 		updateRouteData(&routes[r]);
 		routes[r].whenLastTestedLargeNb = -1;
-		bestInsertInitializedForRoute[r] = false;
+	}
+
+	// The insertions of SWAP* are calculated again, since the move counter restarts
+	for (int t = 0; t < static_cast<int>(bestInsertClient.size()); t++)
+	{
+		bestInsertClient[t].clear(params->nbClients);
+		bestInsertClientTW[t].clear(params->nbClients);
 	}
 
 	for (int i = 1; i <= params->nbClients; i++) // Initializing memory structures
@@ -1630,32 +1953,93 @@ void LocalSearch::exportIndividual(Individual* indiv)
 	indiv->evaluateCompleteCost();
 }
 
-LocalSearch::LocalSearch(Params* params) : params(params)
+void LocalSearch::reinitialize(Params* params)
 {
-	clients = std::vector < Node >(params->nbClients + 1);
-	routes = std::vector < Route >(params->nbVehicles);
-	depots = std::vector < Node >(params->nbVehicles);
-	depotsEnd = std::vector < Node >(params->nbVehicles);
-	bestInsertInitializedForRoute = std::vector < bool >(params->nbVehicles, false);
-	bestInsertClient = std::vector < std::vector <ThreeBestInsert> >(params->nbVehicles, std::vector <ThreeBestInsert>(params->nbClients + 1));
-	bestInsertClientTW = std::vector < std::vector <ThreeBestInsert> >(params->nbVehicles, std::vector <ThreeBestInsert>(params->nbClients + 1));
+	// All vectors are resized with assign, which keeps their allocated memory, such that a LocalSearch can be reused for other instances
+	this->params = params;
+	clients.assign(params->nbClients + 1, Node());
+	routes.assign(params->nbVehicles, Route());
+	depots.assign(params->nbVehicles, Node());
+	depotsEnd.assign(params->nbVehicles, Node());
+	isNodeActive.assign(params->nbClients + 1, true);
+	bestInsertClient.resize(std::max(params->config.nbLocalSearchThreads, 1));
+	bestInsertClientTW.resize(std::max(params->config.nbLocalSearchThreads, 1));
+	for (int t = 0; t < static_cast<int>(bestInsertClient.size()); t++)
+	{
+		bestInsertClient[t].clear(params->nbClients);
+		bestInsertClientTW[t].clear(params->nbClients);
+	}
+
+	// The outer vector of routeSegmentTrees never shrinks either, and the trees are cleared since they are built for the routes of another instance
+	if (static_cast<int>(routeSegmentTrees.size()) < params->nbVehicles)
+	{
+		routeSegmentTrees.resize(params->nbVehicles);
+	}
+	for (int r = 0; r < params->nbVehicles; r++)
+	{
+		routeSegmentTrees[r].clear();
+	}
+
+	// Node data arrays: the clients (by index), followed by the depots and the end depots
+	int nbNodes = params->nbClients + 1 + 2 * params->nbVehicles;
+	nodeTwData.assign(nbNodes, TimeWindowData());
+	nodePrefixTwData.assign(nbNodes, TimeWindowData());
+	nodePostfixTwData.assign(nbNodes, TimeWindowData());
+	nodeSeedData.assign(nbNodes, NodeSeedData());
+	nodeCumulatedData.assign(nbNodes, NodeCumulatedData());
+	nodeEdgeCache.assign(nbNodes, NodeEdgeCache());
 
 	for (int i = 0; i <= params->nbClients; i++)
 	{
 		clients[i].cour = i;
+		clients[i].index = i;
 		clients[i].isDepot = false;
 	}
 	for (int i = 0; i < params->nbVehicles; i++)
 	{
 		routes[i].cour = i;
 		routes[i].depot = &depots[i];
+		routes[i].firstModifiedPosition = INT_MAX;
+		routes[i].lastModifiedPosition = INT_MIN;
 		depots[i].cour = 0;
+		depots[i].index = params->nbClients + 1 + i;
 		depots[i].isDepot = true;
 		depots[i].route = &routes[i];
 		depotsEnd[i].cour = 0;
+		depotsEnd[i].index = params->nbClients + 1 + params->nbVehicles + i;
 		depotsEnd[i].isDepot = true;
 		depotsEnd[i].route = &routes[i];
 	}
+	orderNodes.clear();
+	orderRoutes.clear();
 	for (int i = 1; i <= params->nbClients; i++) orderNodes.push_back(i);
 	for (int r = 0; r < params->nbVehicles; r++) orderRoutes.push_back(r);
 }
+
+void LocalSearch::reserve(int maxClients, int maxVehicles)
+{
+	clients.reserve(maxClients + 1);
+	nodeTwData.reserve(maxClients + 1 + 2 * maxVehicles);
+	nodePrefixTwData.reserve(maxClients + 1 + 2 * maxVehicles);
+	nodePostfixTwData.reserve(maxClients + 1 + 2 * maxVehicles);
+	nodeSeedData.reserve(maxClients + 1 + 2 * maxVehicles);
+	nodeCumulatedData.reserve(maxClients + 1 + 2 * maxVehicles);
+	nodeEdgeCache.reserve(maxClients + 1 + 2 * maxVehicles);
+	routes.reserve(maxVehicles);
+	depots.reserve(maxVehicles);
+	depotsEnd.reserve(maxVehicles);
+	isNodeActive.reserve(maxClients + 1);
+	orderNodes.reserve(maxClients);
+	orderRoutes.reserve(maxVehicles);
+	orderNonEmptyRoutes.reserve(maxVehicles);
+	for (int t = 0; t < static_cast<int>(bestInsertClient.size()); t++)
+	{
+		bestInsertClient[t].reserve(maxClients);
+		bestInsertClientTW[t].reserve(maxClients);
+	}
+}
+
+LocalSearch::LocalSearch(Params* params)
+{
+	reinitialize(params);
+}
@@ -29,6 +29,7 @@ SOFTWARE.*/
 
 #include "CircleSector.h"
 #include "Individual.h"
+#include "LocalSearchStatistics.h"
 #include "Params.h"
 
 struct Node;
@@ -56,6 +57,8 @@ struct Route
 	int nbCustomers;					// Number of customers visited in the route
 	int whenLastModified;				// "When" this route has been last modified
 	int whenLastTestedLargeNb;			// "When" the large neighborhood moves for this route have been last tested
+	int firstModifiedPosition;			// Smallest position from which the route may have been modified since its data was last updated (INT_MAX if unmodified)
+	int lastModifiedPosition;			// Largest position up to which the route may have been modified since its data was last updated (INT_MIN if unmodified)
 	bool isDeltaRemovalTWOutdated;		// Flag to indicate deltaRemovalTW data of nodes is outdated
 	Node* depot;						// Pointer to the associated depot
 	int duration;						// Total time on the route (driving duration + service duration, excluding waiting time)
@@ -67,10 +70,28 @@ struct Route
 	CircleSector sector;				// Circle sector associated to the set of clients
 };
 
-struct Node
+// Time window data of the edges between a node and its successor in the route, in both directions (see getEdgeTwData)
+struct NodeEdgeCache
+{
+	TimeWindowData toNextTwData;		// TimeWindowData for the edge (cour, next)
+	TimeWindowData fromNextTwData;		// TimeWindowData for the edge (next, cour)
+};
+
+// Cumulated data of a route until a node (including itself), such that updateRouteData can restart from this node
+struct NodeCumulatedData
+{
+	int cumulatedX;						// Sum of the X coordinates of the clients
+	int cumulatedY;						// Sum of the Y coordinates of the clients
+	CircleSector sector;				// Circle sector of the clients
+};
+
+// Node of the linked lists representing the routes. It only contains the data used by all moves, such that it fits in one cache line.
+// The time window data of the nodes is stored apart, in arrays of the LocalSearch indexed by Node::index (see getTwData and related functions)
+struct alignas(64) Node
 {
 	bool isDepot;						// Tells whether this node represents a depot or not
 	int cour;							// Node index
+	int index;							// Index of the node in the node data arrays of the local search (cour for clients)
 	int position;						// Position in the route
 	int whenLastTestedRI;				// "When" the RI moves for this node have been last tested
 	Node* next;							// Next node in the route order
@@ -81,9 +102,11 @@ struct Node
 	int cumulatedReversalDistance;		// Difference of cost if the segment of route (0...cour) is reversed (useful for 2-opt moves with asymmetric problems)
 	int deltaRemoval;					// Difference of cost in the current route if the node is removed (used in SWAP*)
 	int deltaRemovalTW;					// Difference of cost in the current route if the node is removed, including TimeWarp (used in SWAP*)
-	TimeWindowData twData;				// TimeWindowData for individual node (cour)
-	TimeWindowData prefixTwData;		// TimeWindowData for subsequence (0...cour) including self
-	TimeWindowData postfixTwData;		// TimeWindowData for subsequence (cour...0) including self
+};
+
+// Seed data of a node, used to calculate the time window data of a route segment in fewer steps (only used by getRouteSegmentTwData)
+struct NodeSeedData
+{
 	bool isSeed;						// Tells whether a nextSeed is available (faster twData calculations)
 	TimeWindowData toNextSeedTwD;		// TimeWindowData for subsequence (cour...cour+4) excluding self, including cour + 4
 	Node* nextSeed;						// next seeded node if available (nullptr otherwise)
@@ -137,10 +160,63 @@ struct ThreeBestInsert
 	ThreeBestInsert() { reset(); };
 };
 
+// Structure used in SWAP* to remember the three best insertion positions of the clients in the routes in which they have been evaluated recently.
+// Each client has a fixed number of slots tagged with a route index, such that the memory is linear in the number of clients, whereas a table
+// for all routes and clients is quadratic when the number of vehicles is not limited. When all slots of a client are used, the slot of a route that has
+// been modified since it was calculated, or otherwise the slot calculated the longest ago, is replaced (it is calculated again if it is needed later)
+struct ThreeBestInsertCache
+{
+	static constexpr int nbSlotsPerClient = 8;		// Number of routes for which the insertions of a client are remembered
+	std::vector<int> slotRoutes;					// For each client and slot, the index of the route of the slot (-1 if unused)
+	std::vector<ThreeBestInsert> slots;				// For each client and slot, the three best insertion positions in this route
+
+	// Allocates memory for up to maxClients clients, such that clear does not need to allocate
+	void reserve(int maxClients)
+	{
+		slotRoutes.reserve(static_cast<size_t>(maxClients + 1) * nbSlotsPerClient);
+		slots.reserve(static_cast<size_t>(maxClients + 1) * nbSlotsPerClient);
+	}
+
+	// Empties all slots, for nbClients clients
+	void clear(int nbClients)
+	{
+		slotRoutes.assign(static_cast<size_t>(nbClients + 1) * nbSlotsPerClient, -1);
+		slots.resize(static_cast<size_t>(nbClients + 1) * nbSlotsPerClient);
+	}
+
+	// Returns the slot of the client for the route (with whenLastCalculated = -1 if the route had no slot), where routes are all routes of the local search
+	ThreeBestInsert& get(int client, const Route* route, const std::vector<Route>& routes)
+	{
+		int first = client * nbSlotsPerClient;
+		for (int i = first; i < first + nbSlotsPerClient; i++)
+		{
+			if (slotRoutes[i] == route->cour) return slots[i];
+		}
+
+		// Replace an unused slot, an outdated slot, or the slot calculated the longest ago (in this order of preference)
+		int replaced = first;
+		long long replacedPriority = LLONG_MAX;
+		for (int i = first; i < first + nbSlotsPerClient; i++)
+		{
+			long long priority = slotRoutes[i] == -1 ? -2
+				: routes[slotRoutes[i]].whenLastModified > slots[i].whenLastCalculated ? -1
+				: slots[i].whenLastCalculated;
+			if (priority < replacedPriority)
+			{
+				replaced = i;
+				replacedPriority = priority;
+			}
+		}
+		slotRoutes[replaced] = route->cour;
+		slots[replaced].whenLastCalculated = -1;
+		return slots[replaced];
+	}
+};
+
 // Structured used to keep track of the best SWAP* move
 struct SwapStarElement
 {
-	double moveCost = 1.e30;
+	double moveCost = 1.e30;			// Estimated cost of the move during the evaluation, then its actual cost (see evaluateSwapStar)
 	double loadPenU = 1.e30;
 	double loadPenV = 1.e30;
 	Node* U = nullptr;
@@ -149,6 +225,27 @@ struct SwapStarElement
 	Node* bestPositionV = nullptr;
 };
 
+// Structure used to keep track of the best RELOCATE* move
+struct RelocateStarElement
+{
+	double moveCost = 1.e30;			// Cost of the move
+	Node* U = nullptr;					// Node to relocate (nullptr if there is no improving move)
+	Node* bestPositionU = nullptr;		// Node after which U is inserted
+};
+
+// Best RELOCATE* or SWAP* move of a pair of routes, evaluated in parallel with the other route pairs (see parallelSwapStar)
+struct RoutePairMove
+{
+	Route* routeU;						// First route of the pair
+	Route* routeV;						// Second route of the pair
+	bool isSwapStar;					// Tells whether the move is a SWAP* (otherwise a RELOCATE*)
+	RelocateStarElement relocateStar;	// Best RELOCATE* move of the pair
+	SwapStarElement swapStar;			// Best SWAP* move of the pair (if there is no improving RELOCATE* move)
+
+	// Cost of the move (not improving if above -MY_EPSILON)
+	double moveCost() const { return isSwapStar ? swapStar.moveCost : relocateStar.moveCost; }
+};
+
 // Main local learch structure
 class LocalSearch
 {
@@ -159,18 +256,31 @@ private:
 	bool searchCompleted;						// Tells whether all moves have been evaluated without success
 	int nbMoves;								// Total number of moves (RI and SWAP*) applied during the local search. Attention: this is not only a simple counter, it is also used to avoid repeating move evaluations
 	std::vector < int > orderNodes;				// Randomized order for checking the nodes in the RI local search
+	std::vector < bool > isNodeActive;			// Don't-look bits of the RI local search: tells whether the moves of a client must be evaluated (only if config.useDontLookBits)
 	std::vector < int > orderRoutes;			// Randomized order for checking the routes in the SWAP* local search
+	std::vector < int > orderNonEmptyRoutes;	// Non-empty routes in the order of orderRoutes, at the start of the SWAP* local search
 	std::set < int > emptyRoutes;				// indices of all empty routes
 	int loopID;									// Current loop index
+	LocalSearchStatistics statistics;			// Counters per operator and filter (only updated if compiled with LS_STATISTICS)
 
 	/* THE SOLUTION IS REPRESENTED AS A LINKED LIST OF ELEMENTS */
 	std::vector < Node > clients;				// Elements representing clients (clients[0] is a sentinel and should not be accessed)
 	std::vector < Node > depots;				// Elements representing depots
 	std::vector < Node > depotsEnd;				// Duplicate of the depots to mark the end of the routes
 	std::vector < Route > routes;				// Elements representing routes
-	std::vector<bool> bestInsertInitializedForRoute;
-	std::vector < std::vector < ThreeBestInsert > > bestInsertClient;   // (SWAP*) For each route and node, storing the cheapest insertion cost (excluding TW)
-	std::vector < std::vector < ThreeBestInsert > > bestInsertClientTW;   // (SWAP*) For each route and node, storing the cheapest insertion cost (including TW)
+
+	/* DATA OF THE NODES (CLIENTS, THEN DEPOTS, THEN END DEPOTS), STORED IN SEPARATE ARRAYS INDEXED BY Node::index */
+	std::vector < TimeWindowData > nodeTwData;			// TimeWindowData for individual node (cour)
+	std::vector < TimeWindowData > nodePrefixTwData;	// TimeWindowData for subsequence (0...cour) including self
+	std::vector < TimeWindowData > nodePostfixTwData;	// TimeWindowData for subsequence (cour...0) including self
+	std::vector < NodeSeedData > nodeSeedData;			// Seed data of the nodes, only used by getRouteSegmentTwData
+	std::vector < NodeCumulatedData > nodeCumulatedData;	// Cumulated data of the nodes, only used by updateRouteData
+	std::vector < NodeEdgeCache > nodeEdgeCache;		// Time window data of the edges to the successors of the nodes, only used by getEdgeTwData
+
+	std::vector < ThreeBestInsertCache > bestInsertClient;		// (SWAP*) For recently evaluated routes and nodes, storing the cheapest insertion cost (excluding TW), per thread
+	std::vector < ThreeBestInsertCache > bestInsertClientTW;	// (SWAP*) For recently evaluated routes and nodes, storing the cheapest insertion cost (including TW), per thread
+	std::vector < RoutePairMove > routePairMoves;				// (SWAP*) Route pairs evaluated in parallel and their best moves (only if config.nbLocalSearchThreads > 1)
+	std::vector < std::vector < TimeWindowData > > routeSegmentTrees;	// For each route, segment tree over the time window data of its nodes (only if config.useRouteSegmentTree)
 
 	/* TEMPORARY VARIABLES USED IN THE LOCAL SEARCH LOOPS */
 	// nodeUPrev -> nodeU -> nodeX -> nodeXNext
@@ -219,18 +329,39 @@ private:
 	bool ReorderTWsIfNeeded(); // For the current route try to order all TWs
 
 	/* SUB-ROUTINES FOR EFFICIENT SWAP* EVALUATIONS */
+	// The evaluation functions only read the solution and write to the given cache, such that route pairs can be evaluated in parallel
 	bool swapStar(bool withTW); // Calculates all SWAP* between routeU and routeV and apply the best improving move
-	int getCheapestInsertSimultRemoval(Node* U, Node* V, Node*& bestPosition); // Calculates the insertion cost and position in the route of V, where V is omitted
-	int getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& bestPosition); // Calculates the insertion cost and position in the route of V, where V is omitted
-	void preprocessInsertions(Route* R1, Route* R2); // Preprocess all insertion costs of nodes of route R1 in route R2
-	void preprocessInsertionsWithTW(Route* R1, Route* R2); // Preprocess all insertion costs of nodes of route R1 in route R2
+	SwapStarElement evaluateSwapStar(Route* RU, Route* RV, bool withTW, ThreeBestInsertCache& cache); // Calculates the best SWAP* between RU and RV (preprocessRemovals must be called first)
+	void applySwapStar(const SwapStarElement& move); // Applies a SWAP* move
+	int getCheapestInsertSimultRemoval(Node* U, Node* V, Node*& bestPosition, ThreeBestInsertCache& cache); // Calculates the insertion cost and position in the route of V, where V is omitted
+	int getCheapestInsertSimultRemovalWithTW(Node* U, Node* V, Node*& bestPosition, ThreeBestInsertCache& cache); // Calculates the insertion cost and position in the route of V, where V is omitted
+	void preprocessRemovals(Route* R1, bool withTW); // Preprocess the removal costs of the nodes of route R1 (deltaRemoval or deltaRemovalTW)
+	void preprocessInsertions(Route* R1, Route* R2, ThreeBestInsertCache& cache); // Preprocess all insertion costs of nodes of route R1 in route R2
+	void preprocessInsertionsWithTW(Route* R1, Route* R2, ThreeBestInsertCache& cache); // Preprocess all insertion costs of nodes of route R1 in route R2
 
 	/* RELOCATE MOVES BETWEEN TRIPS*/
-	bool RelocateStar(); // Calculates all SWAP* between nodeU and all routes recently changed
+	bool RelocateStar(); // Calculates all RELOCATE* from routeU to routeV and apply the best improving move
+	RelocateStarElement evaluateRelocateStar(Route* RU, Route* RV, ThreeBestInsertCache& cacheTW); // Calculates the best RELOCATE* from RU to RV
+	void applyRelocateStar(const RelocateStarElement& move); // Applies a RELOCATE* move
+
+	/* PARALLEL EVALUATION OF THE SWAP* AND RELOCATE* MOVES */
+	// Evaluates the RELOCATE* and SWAP* moves of the route pairs whose circle sectors overlap with config.nbLocalSearchThreads threads, on the same solution,
+	// and then applies the improving moves in the order of the pairs, skipping moves of routes that have already been modified by a previous move
+	void parallelSwapStar();
+	void evaluateRoutePair(RoutePairMove& pairMove, int threadIdx); // Evaluates the best RELOCATE* or SWAP* move of a route pair, like the sequential version
 
 	/* SUB-ROUTINES FOR TIME WINDOWS */
-	TimeWindowData getEdgeTwData(Node* U, Node* V); // Calculates time window data for edge between U and V, does not have to be currently adjacent
+	// Access to the node data arrays
+	TimeWindowData& getTwData(const Node* U) { return nodeTwData[U->index]; }
+	TimeWindowData& getPrefixTwData(const Node* U) { return nodePrefixTwData[U->index]; }
+	TimeWindowData& getPostfixTwData(const Node* U) { return nodePostfixTwData[U->index]; }
+	NodeSeedData& getSeedData(const Node* U) { return nodeSeedData[U->index]; }
+	NodeCumulatedData& getCumulatedData(const Node* U) { return nodeCumulatedData[U->index]; }
+	NodeEdgeCache& getEdgeCache(const Node* U) { return nodeEdgeCache[U->index]; }
+
+	TimeWindowData getEdgeTwData(Node* U, Node* V); // Calculates time window data for edge between U and V, does not have to be currently adjacent (but is cached if they are)
 	TimeWindowData getRouteSegmentTwData(Node* U, Node* V); // Calculates time window data for segment in single route
+	TimeWindowData getRouteSegmentTwDataFromTree(Route* myRoute, int firstPosition, int lastPosition); // Same, for the positions [firstPosition, lastPosition] using the segment tree
 	TimeWindowData MergeTWDataRecursive(const TimeWindowData& twData1, const TimeWindowData& twData2);
 
 	template <typename... Args>
@@ -243,7 +374,19 @@ private:
 	/* ROUTINES TO UPDATE THE SOLUTIONS */
 	static void insertNode(Node* U, Node* V);		// Solution update: Insert U after V
 	static void swapNode(Node* U, Node* V);		// Solution update: Swap U and V
-	void updateRouteData(Route* myRoute);			// Updates the preprocessed data of a route
+	void updateRouteData(Route* myRoute);			// Updates the preprocessed data of a route (only of its modified part, see setRouteModified)
+	void updateRouteSegmentTree(Route* myRoute, Node* firstNode);	// Updates the segment tree of a route for the nodes from firstNode onwards
+
+	// Records that the nodes of myRoute (by position before the modification) from firstPosition onwards may have a different predecessor,
+	// and up to lastPosition may have a different successor. Positions may be outdated within a move: the range is then only enlarged
+	static void setRouteModified(Route* myRoute, int firstPosition, int lastPosition)
+	{
+		myRoute->firstModifiedPosition = std::min(myRoute->firstModifiedPosition, firstPosition);
+		myRoute->lastModifiedPosition = std::max(myRoute->lastModifiedPosition, lastPosition);
+	}
+
+	// Records that myRoute has been modified completely (for example when it was built without insertNode)
+	static void setRouteModified(Route* myRoute) { setRouteModified(myRoute, 1, INT_MAX); }
 	CostSol getCostSol(bool usePenaltiesLS = true);	// Computes cost and penalties for solutions, only used for additional (debug) checks
 
 public:
@@ -274,6 +417,19 @@ public:
 	// Exporting the LS solution into an individual and calculating the penalized cost according to the original penalty weights from Params
 	void exportIndividual(Individual* indiv);
 
+	// Number of moves applied during the last run of the local search
+	int getNbMoves() const { return nbMoves; }
+
+	// Counters per operator and filter since the construction of this LocalSearch (only updated if compiled with LS_STATISTICS)
+	const LocalSearchStatistics& getStatistics() const { return statistics; }
+
+	// Prepares the data structures for the instance of params, reusing the memory that was already allocated
+	void reinitialize(Params* params);
+
+	// Allocates memory for instances with up to maxClients clients and maxVehicles vehicles, such that reinitialize does not need to allocate
+	// Attention: reinitialize should be called afterwards, since the data structures may be moved in memory
+	void reserve(int maxClients, int maxVehicles);
+
 	// Constructor
 	LocalSearch(Params* params);
 };
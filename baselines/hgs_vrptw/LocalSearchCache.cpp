@@ -0,0 +1,72 @@
+#include <functional>
+#include <iterator>
+
+#include "Individual.h"
+#include "LocalSearchCache.h"
+
+size_t LocalSearchCache::KeyHash::operator()(const Key& key) const
+{
+	return static_cast<size_t>(key.arcHash) ^ (std::hash<double>()(key.penaltyCapacity) * 31) ^ (std::hash<double>()(key.penaltyTimeWarp) * 17);
+}
+
+bool LocalSearchCache::lookup(uint64_t arcHash, double penaltyCapacity, double penaltyTimeWarp, Individual* indiv)
+{
+	nbLookups++;
+	auto it = entryPerKey.find({ arcHash, penaltyCapacity, penaltyTimeWarp });
+	if (it == entryPerKey.end())
+	{
+		return false;
+	}
+	nbHits++;
+
+	// Move the result to the front of the list of the most recently used results
+	entries.splice(entries.begin(), entries, it->second);
+
+	// Copy the routes of the local optimum, and fill the giant tour in the order of the routes (as LocalSearch::exportIndividual does)
+	indiv->chromR = it->second->chromR;
+	int pos = 0;
+	for (const std::vector<int>& route : indiv->chromR)
+	{
+		for (int client : route)
+		{
+			indiv->chromT[pos] = client;
+			pos++;
+		}
+	}
+	indiv->evaluateCompleteCost();
+	return true;
+}
+
+void LocalSearchCache::insert(uint64_t arcHash, double penaltyCapacity, double penaltyTimeWarp, const Individual* localOptimum)
+{
+	Key key = { arcHash, penaltyCapacity, penaltyTimeWarp };
+	if (capacity <= 0 || entryPerKey.find(key) != entryPerKey.end())
+	{
+		return;
+	}
+
+	// Evict the least recently used result if the cache is full (reusing its memory for the new result)
+	if (static_cast<int>(entries.size()) >= capacity)
+	{
+		entryPerKey.erase(entries.back().key);
+		entries.splice(entries.begin(), entries, std::prev(entries.end()));
+		entries.front().key = key;
+		entries.front().chromR = localOptimum->chromR;
+	}
+	else
+	{
+		entries.push_front({ key, localOptimum->chromR });
+	}
+	entryPerKey[key] = entries.begin();
+}
+
+void LocalSearchCache::clear()
+{
+	entries.clear();
+	entryPerKey.clear();
+}
+
+LocalSearchCache::LocalSearchCache(int capacity) : capacity(capacity), nbLookups(0), nbHits(0)
+{
+	entryPerKey.reserve(capacity > 0 ? capacity : 0);
+}
@@ -0,0 +1,96 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#ifndef LOCALSEARCHCACHE_H
+#define LOCALSEARCHCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+class Individual;
+
+// Bounded cache of local search results: maps a solution (by its arc hash) and the penalty parameters of the local search to the routes
+// of the local optimum that was found from this solution. When the cache is full, the least recently used result is evicted
+class LocalSearchCache
+{
+private:
+	// Solution and penalty parameters given to the local search
+	struct Key
+	{
+		uint64_t arcHash;										// Arc hash of the solution before the local search
+		double penaltyCapacity;									// Penalty for one unit of capacity excess
+		double penaltyTimeWarp;									// Penalty for one unit time warp
+
+		bool operator==(const Key& other) const
+		{
+			return arcHash == other.arcHash && penaltyCapacity == other.penaltyCapacity && penaltyTimeWarp == other.penaltyTimeWarp;
+		}
+	};
+
+	// Hash function of the keys (the arc hash is already uniformly distributed)
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	// Result of the local search for one key
+	struct Entry
+	{
+		Key key;												// Solution and penalty parameters given to the local search
+		std::vector<std::vector<int>> chromR;					// Routes of the local optimum
+	};
+
+	int capacity;												// Maximum number of results in the cache (0 if the cache is disabled)
+	std::list<Entry> entries;									// Results, from the most recently used to the least recently used
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entryPerKey;	// Position of the result of each key in entries
+	long long nbLookups;										// Number of lookups since the construction of the cache
+	long long nbHits;											// Number of lookups that found a result
+
+public:
+	// Looks up the local optimum found from a solution with the given arc hash and penalty parameters.
+	// If it is in the cache, indiv is replaced by the local optimum (and its cost evaluated), and true is returned
+	bool lookup(uint64_t arcHash, double penaltyCapacity, double penaltyTimeWarp, Individual* indiv);
+
+	// Stores localOptimum as the result of the local search from a solution with the given arc hash and penalty parameters
+	void insert(uint64_t arcHash, double penaltyCapacity, double penaltyTimeWarp, const Individual* localOptimum);
+
+	// Removes all results from the cache (the counters are kept)
+	void clear();
+
+	// Tells whether the cache is enabled (capacity > 0)
+	bool isEnabled() const { return capacity > 0; }
+
+	// Number of lookups since the construction of the cache
+	long long getNbLookups() const { return nbLookups; }
+
+	// Number of lookups that found a result since the construction of the cache
+	long long getNbHits() const { return nbHits; }
+
+	// Constructor: empty cache for at most capacity results (0 to disable the cache)
+	LocalSearchCache(int capacity);
+};
+
+#endif
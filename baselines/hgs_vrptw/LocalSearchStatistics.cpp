@@ -0,0 +1,62 @@
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "LocalSearchStatistics.h"
+
+void LocalSearchStatistics::add(const LocalSearchStatistics& other)
+{
+	for (int i = 0; i < static_cast<int>(operators.size()); i++)
+	{
+		operators[i].nbEvaluations += other.operators[i].nbEvaluations;
+		operators[i].nbApplied += other.operators[i].nbApplied;
+		operators[i].totalGain += other.operators[i].totalGain;
+		operators[i].seconds += other.operators[i].seconds;
+	}
+	for (auto [filter, otherFilter] : { std::pair(&routeModifiedRI, &other.routeModifiedRI),
+		std::pair(&routeModifiedSwapStar, &other.routeModifiedSwapStar), std::pair(&circleSectorOverlap, &other.circleSectorOverlap) })
+	{
+		filter->nbTested += otherFilter->nbTested;
+		filter->nbRejected += otherFilter->nbRejected;
+	}
+}
+
+void LocalSearchStatistics::exportCSV(const std::string& fileName) const
+{
+	// Create the file to write to
+	std::ofstream myfile(fileName);
+	if (!myfile.is_open())
+	{
+		throw std::string("Impossible to write the local search statistics to " + fileName);
+	}
+
+	// For the filters, the evaluations are the number of times the filter was tested, and the applied moves are the number of rejections
+	myfile << "name;evaluations;applied;gain;seconds" << std::endl;
+	for (int i = 0; i < static_cast<int>(operators.size()); i++)
+	{
+		const OperatorStatistics& op = operators[i];
+		myfile << getOperatorName(static_cast<LocalSearchOperator>(i)) << ";" << op.nbEvaluations << ";" << op.nbApplied << ";" << op.totalGain << ";" << op.seconds << std::endl;
+	}
+	myfile << "FilterRouteModifiedRI;" << routeModifiedRI.nbTested << ";" << routeModifiedRI.nbRejected << ";0;0" << std::endl;
+	myfile << "FilterRouteModifiedSwapStar;" << routeModifiedSwapStar.nbTested << ";" << routeModifiedSwapStar.nbRejected << ";0;0" << std::endl;
+	myfile << "FilterCircleSectorOverlap;" << circleSectorOverlap.nbTested << ";" << circleSectorOverlap.nbRejected << ";0;0" << std::endl;
+}
+
+const char* LocalSearchStatistics::getOperatorName(LocalSearchOperator op)
+{
+	switch (op)
+	{
+	case LocalSearchOperator::MoveSingleClient: return "MoveSingleClient";
+	case LocalSearchOperator::MoveTwoClients: return "MoveTwoClients";
+	case LocalSearchOperator::MoveTwoClientsReversed: return "MoveTwoClientsReversed";
+	case LocalSearchOperator::SwapTwoSingleClients: return "SwapTwoSingleClients";
+	case LocalSearchOperator::SwapTwoClientsForOne: return "SwapTwoClientsForOne";
+	case LocalSearchOperator::SwapTwoClientPairs: return "SwapTwoClientPairs";
+	case LocalSearchOperator::TwoOptWithinTrip: return "TwoOptWithinTrip";
+	case LocalSearchOperator::TwoOptBetweenTrips: return "TwoOptBetweenTrips";
+	case LocalSearchOperator::SwapStar: return "SwapStar";
+	case LocalSearchOperator::SwapStarTW: return "SwapStarTW";
+	case LocalSearchOperator::RelocateStar: return "RelocateStar";
+	default: return "Unknown";
+	}
+}
@@ -0,0 +1,122 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#ifndef LOCALSEARCHSTATISTICS_H
+#define LOCALSEARCHSTATISTICS_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+// Operators of the local search for which statistics are collected
+enum class LocalSearchOperator
+{
+	MoveSingleClient,
+	MoveTwoClients,
+	MoveTwoClientsReversed,
+	SwapTwoSingleClients,
+	SwapTwoClientsForOne,
+	SwapTwoClientPairs,
+	TwoOptWithinTrip,
+	TwoOptBetweenTrips,
+	SwapStar,
+	SwapStarTW,
+	RelocateStar,
+	NbOperators
+};
+
+// Statistics of one operator
+struct OperatorStatistics
+{
+	long long nbEvaluations = 0;		// Number of times the operator has been evaluated
+	long long nbApplied = 0;			// Number of improving moves applied
+	double totalGain = 0.;				// Sum of the decreases of penalized cost of the applied moves
+	double seconds = 0.;				// Time spent in the operator (evaluation and application of the moves)
+};
+
+// Statistics of the filters that avoid evaluating moves
+struct FilterStatistics
+{
+	long long nbTested = 0;				// Number of times the filter has been tested
+	long long nbRejected = 0;			// Number of times the filter rejected the evaluation
+};
+
+// Counters of the local search, per operator and per filter, to tune which operators are worth running on a set of instances.
+// The counters are only updated if the program is compiled with LS_STATISTICS (see the Makefile), since measuring the time of every
+// evaluation slows down the local search. Otherwise, the LS_STATISTICS_* macros below are empty and all counters stay zero.
+// The SWAP* and RELOCATE* moves evaluated in parallel (config.nbLocalSearchThreads > 1) are not counted, only their filters
+class LocalSearchStatistics
+{
+public:
+	std::array<OperatorStatistics, static_cast<int>(LocalSearchOperator::NbOperators)> operators;	// Statistics per operator
+	FilterStatistics routeModifiedRI;			// RI moves of a node pair skipped since their routes have not been modified since the last evaluation
+	FilterStatistics routeModifiedSwapStar;		// SWAP* and RELOCATE* of a route pair skipped since the routes have not been modified since the last evaluation
+	FilterStatistics circleSectorOverlap;		// SWAP* and RELOCATE* of a route pair skipped since the circle sectors of the routes do not overlap
+
+	// Records the evaluation of an operator, from construction to destruction of this object
+	class Evaluation
+	{
+	public:
+		Evaluation(LocalSearchStatistics& statistics, LocalSearchOperator op) : statistics(statistics), op(op), start(std::chrono::steady_clock::now()) {}
+		~Evaluation()
+		{
+			OperatorStatistics& opStatistics = statistics.operators[static_cast<int>(op)];
+			opStatistics.nbEvaluations++;
+			opStatistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		// Records that the evaluated move is applied, with a change of penalized cost of moveCost (negative)
+		void applied(double moveCost)
+		{
+			statistics.operators[static_cast<int>(op)].nbApplied++;
+			statistics.operators[static_cast<int>(op)].totalGain -= moveCost;
+		}
+
+	private:
+		LocalSearchStatistics& statistics;							// Statistics to update
+		LocalSearchOperator op;										// Operator that is evaluated
+		std::chrono::steady_clock::time_point start;				// Start of the evaluation
+	};
+
+	// Adds the counters of other to the counters of this object (for example to sum the statistics of several islands)
+	void add(const LocalSearchStatistics& other);
+
+	// Writes the statistics to a CSV file, with one line per operator and per filter
+	void exportCSV(const std::string& fileName) const;
+
+	// Name of an operator, as written in the CSV file
+	static const char* getOperatorName(LocalSearchOperator op);
+};
+
+#ifdef LS_STATISTICS
+#define LS_STATISTICS_EVALUATION(op) LocalSearchStatistics::Evaluation statisticsEvaluation(statistics, op)
+#define LS_STATISTICS_APPLIED(moveCost) statisticsEvaluation.applied(moveCost)
+#define LS_STATISTICS_FILTER(filter, isRejected) do { statistics.filter.nbTested++; if (isRejected) statistics.filter.nbRejected++; } while (false)
+#else
+#define LS_STATISTICS_EVALUATION(op) ((void)0)
+#define LS_STATISTICS_APPLIED(moveCost) ((void)0)
+#define LS_STATISTICS_FILTER(filter, isRejected) ((void)0)
+#endif
+
+#endif
@@ -1,37 +1,192 @@
-
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 
-// Implementation of a matrix in a C++ vector
+// Implementation of a matrix of elements of type T in a C++ vector
 // This class is used because a flat vector is faster than a vector of vectors which requires two lookup operations rather than one to index a matrix element
-class Matrix
+// The values are either owned by the matrix, or stored in external memory (e.g., a memory mapped instance file) which is kept alive by the matrix
+template <typename T>
+class MatrixOf
 {
-    int cols_;                  // The number of columns of the matrix
-    std::vector<int> data_;     // The vector where all the data is stored (this represents the matrix)
+    int cols_;                              // The number of columns of the matrix
+    std::vector<T> storage_;                // The vector where all the data is stored, if the matrix owns its data (this represents the matrix)
+    std::shared_ptr<const void> external_;  // Keeps the external memory alive, if the matrix does not own its data
+    const T* data_;                         // Pointer to the first element of the matrix (in storage_ or in the external memory)
 
 public:
     // Empty constructor: with zero columns and a vector of size zero
-    Matrix() : cols_(0), data_(std::vector<int>(0))
+    MatrixOf() : cols_(0), data_(nullptr)
+    {}
+
+    // Constructor: create a matrix of size dimension by dimension, using a C++ vector of size dimension * dimension
+    MatrixOf(const int dimension) : cols_(dimension)
+    {
+        storage_ = std::vector<T>(static_cast<size_t>(dimension) * dimension);
+        data_ = storage_.data();
+    }
+
+    // Constructor: create a read-only matrix of size dimension by dimension on external memory (row-major), without copying it.
+    // The memory stays valid as long as external (or a copy of this matrix) is alive
+    MatrixOf(const int dimension, const T* data, std::shared_ptr<const void> external) : cols_(dimension), external_(std::move(external)), data_(data)
     {}
 
-    // Constructor: create a matrix of size dimension by dimension, using a C++ vector of size dimension * dimension 
-    Matrix(const int dimension) : cols_(dimension)
+    // Copy and move constructors and assignments, which make sure data_ points to the storage of the matrix itself (if it owns its data)
+    MatrixOf(const MatrixOf& other) : cols_(other.cols_), storage_(other.storage_), external_(other.external_)
+    {
+        data_ = other.external_ ? other.data_ : storage_.data();
+    }
+    MatrixOf(MatrixOf&& other) noexcept : cols_(other.cols_), storage_(std::move(other.storage_)), external_(std::move(other.external_))
+    {
+        data_ = external_ ? other.data_ : storage_.data();
+    }
+    MatrixOf& operator=(MatrixOf other) noexcept
+    {
+        cols_ = other.cols_;
+        storage_ = std::move(other.storage_);
+        data_ = other.external_ ? other.data_ : storage_.data();
+        external_ = std::move(other.external_);
+        return *this;
+    }
+
+    // Set a value val at position (row, col) in the matrix (only for matrices that own their data)
+    void set(const int row, const int col, const T val)
+    {
+        storage_[static_cast<size_t>(cols_) * row + col] = val;
+    }
+
+    // Get the value at position (row, col) in the matrix
+    T get(const int row, const int col) const
+    {
+        return data_[static_cast<size_t>(cols_) * row + col];
+    }
+
+    // The number of columns (and rows) of the matrix
+    int size() const
+    {
+        return cols_;
+    }
+
+    // Tells whether the matrix is a view on external memory
+    bool isExternal() const
+    {
+        return external_ != nullptr;
+    }
+
+    // Pointer to all elements of the matrix (row-major)
+    const T* data() const
+    {
+        return data_;
+    }
+};
+
+// Distance matrix, stored with 16-bit elements if all values fit, and with 32-bit elements otherwise.
+// The matrix is created with 32-bit elements, and can be converted to 16-bit elements with narrow() once all values are set.
+// Halving the size of the matrix means that twice as many distances stay in cache during the local search
+class Matrix
+{
+    MatrixOf<int> wide_;                    // The matrix with 32-bit elements (empty if narrow)
+    MatrixOf<uint16_t> narrow_;             // The matrix with 16-bit elements (empty if not narrow)
+    const int* wideData_;                   // Pointer to the elements of wide_ (cached here, such that get() needs a single indirection)
+    const uint16_t* narrowData_;            // Pointer to the elements of narrow_
+    int cols_;                              // The number of columns of the matrix
+    bool isNarrow_;                         // Tells whether narrow_ is used (the branch on this flag in get() is perfectly predictable)
+
+    // Points the cached pointers and dimension to the matrix that is used
+    void setView()
     {
-        data_ = std::vector<int>(dimension * dimension);
+        isNarrow_ = narrow_.size() > 0;
+        wideData_ = wide_.data();
+        narrowData_ = narrow_.data();
+        cols_ = isNarrow_ ? narrow_.size() : wide_.size();
     }
 
-    // Set a value val at position (row, col) in the matrix
+public:
+    // Empty constructor: with zero columns and a vector of size zero
+    Matrix()
+    {
+        setView();
+    }
+
+    // Constructor: create a matrix of size dimension by dimension with 32-bit elements
+    Matrix(const int dimension) : wide_(dimension)
+    {
+        setView();
+    }
+
+    // Constructor: create a read-only matrix of size dimension by dimension with 32-bit elements on external memory (row-major), without copying it.
+    // The memory stays valid as long as external (or a copy of this matrix) is alive
+    Matrix(const int dimension, const int* data, std::shared_ptr<const void> external) : wide_(dimension, data, std::move(external))
+    {
+        setView();
+    }
+
+    // Copy and move constructors and assignments, which make sure the cached pointers point to the storage of the matrix itself
+    Matrix(const Matrix& other) : wide_(other.wide_), narrow_(other.narrow_)
+    {
+        setView();
+    }
+    Matrix(Matrix&& other) noexcept : wide_(std::move(other.wide_)), narrow_(std::move(other.narrow_))
+    {
+        setView();
+    }
+    Matrix& operator=(Matrix other) noexcept
+    {
+        wide_ = std::move(other.wide_);
+        narrow_ = std::move(other.narrow_);
+        setView();
+        return *this;
+    }
+
+    // Set a value val at position (row, col) in the matrix (only for matrices that own their data and have not been narrowed)
     void set(const int row, const int col, const int val)
     {
-        data_[cols_ * row + col] = val;
+        wide_.set(row, col, val);
     }
 
     // Get the value at position (row, col) in the matrix
     int get(const int row, const int col) const
     {
-        return data_[cols_ * row + col];
+        size_t index = static_cast<size_t>(cols_) * row + col;
+        return isNarrow_ ? narrowData_[index] : wideData_[index];
+    }
+
+    // Converts the matrix to 16-bit elements if all values are in [0, 65535], and returns whether the matrix is narrow afterwards.
+    // Matrices on external memory are not converted, since that would copy them
+    bool narrow()
+    {
+        if (isNarrow_ || wide_.isExternal() || wide_.size() == 0)
+        {
+            return isNarrow_;
+        }
+        const int n = wide_.size();
+        const int* values = wide_.data();
+        auto [minValue, maxValue] = std::minmax_element(values, values + static_cast<size_t>(n) * n);
+        if (*minValue < 0 || *maxValue > std::numeric_limits<uint16_t>::max())
+        {
+            return false;
+        }
+        narrow_ = MatrixOf<uint16_t>(n);
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                narrow_.set(i, j, static_cast<uint16_t>(wide_.get(i, j)));
+            }
+        }
+        wide_ = MatrixOf<int>();
+        setView();
+        return true;
+    }
+
+    // Tells whether the matrix is stored with 16-bit elements
+    bool isNarrow() const
+    {
+        return isNarrow_;
     }
 };
 
@@ -25,37 +25,25 @@ SOFTWARE.*/
 #define PARAMS_H
 
 #include <assert.h>
+#include <span>
 #include <string>
 #include <vector>
 #include <limits.h>
 #include <iostream>
 #include <ctime>
 #include <chrono>
+#include <memory>
 
 #include "Matrix.h"
+#include "InstanceData.h"
 #include "xorshift128.h"
 
-#define MY_EPSILON 0.00001		// Precision parameter, used to avoid numerical instabilities
-#define PI 3.14159265359		// Number pi, with 11 decimal precision
-
-// Structure of a Client, including its index, position, and all other variables and parameters
-struct Client
-{
-	int custNum;			// Index of the client
-	int coordX;				// Coordinate X
-	int coordY;				// Coordinate Y
-	int serviceDuration;	// Service duration
-	int demand;				// Demand
-	int earliestArrival;	// Earliest arrival (when using time windows)
-	int latestArrival;		// Latest arrival (when using time windows)
-	int releaseTime;	// Release time (when using time windows, route containing this customer cannot depart before this time)
-	int polarAngle;			// Polar angle of the client around the depot (starting at east, moving counter-clockwise), measured in degrees and truncated for convenience
-};
-
 // This is needed for the initialization of a Params variable
 class CommandLine;
 
-// Class that stores all the parameters (from the command line) (in Config) and data of the instance needed by the algorithm
+// Class that stores the state of one search context: all the parameters (from the command line) (in Config), the random number generator,
+// the adaptive penalties and the granular neighborhoods. The data of the instance is stored in an InstanceData object,
+// which is shared (read-only) by all search contexts running on the same instance
 class Params
 {
 public:
@@ -96,6 +84,7 @@ public:
 		int growPopulationAfterIterations = 0;					// The number of iteration after which minimumPopulationSize is grown
 		int growPopulationSize = 0;								// The number minimumPopulationSize is increase by
 		double diversityWeight = 0.;							// Weight for diversity criterium, if 0, weight is 1 - nbElite / populationSize
+		bool rejectClones = false;								// Do not add clones of individuals in the population (based on their edge hash), and skip the local search on offspring that are clones
 		std::string initialSolution = "";						// Initial solution, represented as 'giant tour' with 0 for depot: 1 2 3 0 4 5 6
 
 		// Other parameters
@@ -108,12 +97,22 @@ public:
 		int intensificationProbabilityLS = 15;				// Probability intensification moves are performed during LS ([0-100])
 		bool useSwapStarTW = true;							// Use TW swap star
 		bool skipSwapStarDist = false;						// Skip normal swap star based on distance
+		bool useRouteSegmentTree = false;					// Use a segment tree per route (instead of seeds every 4 nodes) for the time window data of route segments
+		bool useDontLookBits = false;						// Only evaluate the RI moves of clients whose route has been modified since their moves were last evaluated
+		int localSearchCacheSize = 0;						// Maximum number of local search results kept in the cache, by solution and penalties (0 to disable the cache)
+		int nbLocalSearchThreads = 1;						// Number of threads to evaluate the SWAP* moves of the route pairs in parallel (1 for the sequential evaluation)
 		int circleSectorOverlapToleranceDegrees = 0;		// Margin to take (in degrees 0 - 359) to determine overlap of circle sectors for SWAP*
 		int minCircleSectorSizeDegrees = 15;				// Minimum size (in degrees) for circle sectors such that even small circle sectors have 'overlap'
 		int seed = 0;										// Random seed. Default value: 0
 		std::string pathInstance;							// Instance path
 		bool useSymmetricCorrelatedVertices = false;		// When correlation matrix is symmetric
 		bool doRepeatUntilTimeLimit = true;					// When to repeat the algorithm when max nr of iter is reached, but time limit is not
+		bool reorderClients = false;						// Renumber the clients internally along a space filling curve (for cache locality), the output is not affected
+
+		// Parameters of the island model (only used when nbThreads > 1)
+		int nbThreads = 1;									// Number of islands, each running an independent genetic algorithm in its own thread
+		int migrationInterval = 500;						// Number of iterations after which an island sends its elite individuals to the next island
+		int nbMigrants = 2;									// Number of elite individuals sent to the next island at every migration
 	};
 
 	Config config;						// Stores all the parameter values
@@ -126,39 +125,49 @@ public:
 	double penaltyWaitTime;				// Penalty for one unit waiting time (adapted through the search)
 	double penaltyTimeWarp;				// Penalty for one unit time warp (adapted through the search)
 
-	double proximityWeightWaitTime;		// Weight for waiting time in defining the neighbourhood proximities
-	double proximityWeightTimeWarp;		// Weight for time warp in defining the neighbourhood proximities
-
-	// Data of the problem instance
-	std::string instanceName;
-	bool isDurationConstraint;											// Indicates if the problem includes duration constraints
-	bool isTimeWindowConstraint;										// Indicates if the problem includes time window constraints
-	bool isExplicitDistanceMatrix;										// Indicates if the problem is with explicit distances (non-euclidean)
-	int nbClients;														// Number of clients (excluding the depot)
-	int nbVehicles;														// Number of vehicles
-	int durationLimit;													// Route duration limit
-	int vehicleCapacity;												// Capacity limit
-	int totalDemand;													// Total demand required by the clients
-	int maxDemand;														// Maximum demand of a client
-	int maxDist;														// Maximum distance between two clients
-	std::vector<Client> cli;											// Vector containing information on each client (including the depot!)
-	Matrix timeCost;													// Distance matrix (including the depot!)
-	std::vector<std::vector<std::pair<double, int>>> orderProximities;	// For each client, other clients sorted by proximity (size nbClients + 1, but nothing stored for the depot!)
-	std::vector<std::vector<int>> correlatedVertices;					// Neighborhood restrictions: For each client, list of nearby clients (size nbClients + 1, but nothing stored for the depot!)
+	// Data of the problem instance (shared and read-only), the members below are aliases for convenience
+	std::shared_ptr<const InstanceData> instance;						// Data of the problem instance
+	const std::string& instanceName;									// Name of the instance
+	const bool isDurationConstraint;									// Indicates if the problem includes duration constraints
+	const bool isTimeWindowConstraint;									// Indicates if the problem includes time window constraints
+	const bool isExplicitDistanceMatrix;								// Indicates if the problem is with explicit distances (non-euclidean)
+	const int nbClients;												// Number of clients (excluding the depot)
+	const int nbVehicles;												// Number of vehicles
+	const int durationLimit;											// Route duration limit
+	const int vehicleCapacity;											// Capacity limit
+	const int totalDemand;												// Total demand required by the clients
+	const int maxDemand;												// Maximum demand of a client
+	const int maxDist;													// Maximum distance between two clients
+	const std::vector<Client>& cli;										// Vector containing information on each client (including the depot!)
+	const Matrix& timeCost;												// Distance matrix (including the depot!)
+
+	// Data of the search
+	// Neighborhood restrictions: For each client, list of nearby clients (nothing stored for the depot!)
+	// The lists are stored contiguously, with space for correlatedVerticesStride clients per list, such that they can be extended without reallocation
+	std::vector<int> correlatedVertices;								// The list of client i starts at position i * correlatedVerticesStride
+	std::vector<int> nbCorrelatedVertices;								// Number of clients in the list of each client (size nbClients + 1)
+	int correlatedVerticesStride;										// Space reserved for each list in correlatedVertices
+	int nbGranularCorrelated;											// Number of closest clients (in the order proximities) already added to the lists
 	int circleSectorOverlapTolerance;									// Tolerance when determining circle sector overlap (0 - 65536)
 	int minCircleSectorSize;											// Minimum circle sector size to enforce (for nonempty routes) (0 - 65536)
 
 	// Initialization from a given data set
 	Params(const CommandLine&);
 
+	// Initialization of a new search context on an instance that has already been loaded
+	Params(const Config& config, std::shared_ptr<const InstanceData> instance);
+
 	// Get time elapsed since start of program
 	double getTimeElapsedSeconds();
 
 	// Whether time limit is exceeded
 	bool isTimeLimitExceeded();
 
-	// Calculate, for all vertices, the correlation for the nbGranular closest vertices
+	// Calculate, for all vertices, the correlation for the nbGranular closest vertices (only adding the new vertices when nbGranular grew)
 	void SetCorrelatedVertices();
+
+	// List of nearby clients of client i (the list can be reordered, but not resized)
+	std::span<int> getCorrelatedVertices(int i) { return std::span<int>(correlatedVertices.data() + i * correlatedVerticesStride, nbCorrelatedVertices[i]); }
 };
 
 #endif
@@ -10,11 +10,29 @@
 #include "Params.h"
 #include "Split.h"
 #include "LocalSearch.h"
+#include "IslandModel.h"
+
+void Population::runLocalSearch(Individual* indiv, double penaltyCapacity, double penaltyTimeWarp)
+{
+	if (!localSearchCache.isEnabled())
+	{
+		localSearch->run(indiv, penaltyCapacity, penaltyTimeWarp);
+		return;
+	}
+
+	// Only run the local search if its result from this solution with these penalties is not in the cache
+	uint64_t arcHash = indiv->getArcHash();
+	if (!localSearchCache.lookup(arcHash, penaltyCapacity, penaltyTimeWarp, indiv))
+	{
+		localSearch->run(indiv, penaltyCapacity, penaltyTimeWarp);
+		localSearchCache.insert(arcHash, penaltyCapacity, penaltyTimeWarp, indiv);
+	}
+}
 
 void Population::doLocalSearchAndAddIndividual(Individual* indiv)
 {
 	// Do a Local Search
-	localSearch->run(indiv, params->penaltyCapacity, params->penaltyTimeWarp);
+	runLocalSearch(indiv, params->penaltyCapacity, params->penaltyTimeWarp);
 
 	// Add an individual
 	addIndividual(indiv, true);
@@ -22,7 +40,7 @@ void Population::doLocalSearchAndAddIndividual(Individual* indiv)
 	// With a certain probability, repair half of the solutions by increasing the penalties for infeasibilities (w.r.t. capacities and time warps) in a new Local Search in case of infeasibility
 	if (!indiv->isFeasible && params->rng() % 100 < (unsigned int) params->config.repairProbability)
 	{
-		localSearch->run(indiv, params->penaltyCapacity * 10., params->penaltyTimeWarp * 10.);
+		runLocalSearch(indiv, params->penaltyCapacity * 10., params->penaltyTimeWarp * 10.);
 
 		// Add the individual only when feasible
 		if (indiv->isFeasible)
@@ -167,32 +185,33 @@ bool Population::addIndividual(const Individual* indiv, bool updateFeasible)
 		listFeasibilityTimeWarp.pop_front();
 	}
 
-	// Find the adequate subpopulation in relation to the individual feasibility
-	SubPopulation& subpop = (indiv->isFeasible) ? feasibleSubpopulation : infeasibleSubpopulation;
-
-	// Create a copy of the individual and update the proximity structures calculating inter-individual distances
-	Individual* myIndividual = new Individual(*indiv);
-	for (Individual* myIndividual2 : subpop)
+	// Clones of individuals in the population are not added: they do not contribute to the diversity, and would be the first individuals removed by the survivor selection
+	if (!params->config.rejectClones || !hasClone(indiv))
 	{
-		double myDistance = myIndividual->brokenPairsDistance(myIndividual2);
-		myIndividual2->indivsPerProximity.insert({ myDistance, myIndividual });
-		myIndividual->indivsPerProximity.insert({ myDistance, myIndividual2 });
-	}
+		// Find the adequate subpopulation in relation to the individual feasibility
+		SubPopulation& subpop = (indiv->isFeasible) ? feasibleSubpopulation : infeasibleSubpopulation;
 
-	// Identify the correct location in the population and insert the individual
-	int place = static_cast<int>(subpop.size());
-	while (place > 0 && subpop[place - 1]->myCostSol.penalizedCost > indiv->myCostSol.penalizedCost - MY_EPSILON)
-	{
-		place--;
-	}
-	subpop.emplace(subpop.begin() + place, myIndividual);
+		// Create a copy of the individual and update the proximity structure calculating inter-individual distances
+		Individual* myIndividual = new Individual(*indiv);
+		getProximity(subpop).add(myIndividual, subpop);
+		edgeHashCounts[myIndividual->edgeHash]++;
 
-	// Trigger a survivor selection if the maximimum population size is exceeded
-	if (static_cast<int>(subpop.size()) > params->config.minimumPopulationSize + params->config.generationSize)
-	{
-		while (static_cast<int>(subpop.size()) > params->config.minimumPopulationSize)
+		// Identify the correct location in the population and insert the individual
+		int place = static_cast<int>(subpop.size());
+		while (place > 0 && subpop[place - 1]->myCostSol.penalizedCost > indiv->myCostSol.penalizedCost - MY_EPSILON)
+		{
+			place--;
+		}
+		subpop.emplace(subpop.begin() + place, myIndividual);
+		isBiasedFitnessOutdated(subpop) = true;
+
+		// Trigger a survivor selection if the maximimum population size is exceeded
+		if (static_cast<int>(subpop.size()) > params->config.minimumPopulationSize + params->config.generationSize)
 		{
-			removeWorstBiasedFitness(subpop);
+			while (static_cast<int>(subpop.size()) > params->config.minimumPopulationSize)
+			{
+				removeWorstBiasedFitness(subpop);
+			}
 		}
 	}
 
@@ -204,7 +223,12 @@ bool Population::addIndividual(const Individual* indiv, bool updateFeasible)
 		{
 			bestSolutionOverall = *indiv;
 			searchProgress.push_back({ params->getTimeElapsedSeconds(),bestSolutionOverall.myCostSol.penalizedCost });
-			if (params->config.isDimacsRun){
+			if (islandModel != nullptr)
+			{
+				// With multiple islands, only solutions that improve the best solution over all islands are printed
+				islandModel->reportBest(&bestSolutionOverall);
+			}
+			else if (params->config.isDimacsRun){
 				// Since the controller may kill the script at any time, directly write output
 				// bestSolutionOverall.exportCVRPLibFormat(params->config.pathSolution);
 				// exportSearchProgress(params->config.pathSolution + ".PG.csv", params->config.pathInstance, params->config.seed);
@@ -220,13 +244,30 @@ bool Population::addIndividual(const Individual* indiv, bool updateFeasible)
 		return false;
 }
 
+ProximityStructure& Population::getProximity(const SubPopulation& pop)
+{
+	return (&pop == &feasibleSubpopulation) ? feasibleProximity : infeasibleProximity;
+}
+
+bool& Population::isBiasedFitnessOutdated(const SubPopulation& pop)
+{
+	return (&pop == &feasibleSubpopulation) ? isFeasibleBiasedFitnessOutdated : isInfeasibleBiasedFitnessOutdated;
+}
+
 void Population::updateBiasedFitnesses(SubPopulation& pop)
 {
+	// The biased fitnesses only depend on the individuals in the population and their order, so they are only recomputed after a change
+	if (!isBiasedFitnessOutdated(pop))
+	{
+		return;
+	}
+	isBiasedFitnessOutdated(pop) = false;
+
 	// Ranking the individuals based on their diversity contribution (decreasing order of averageBrokenPairsDistanceClosest)
 	std::vector<std::pair<double, int>> ranking;
 	for (int i = 0; i < static_cast<int>(pop.size()); i++)
 	{
-		ranking.push_back({ -pop[i]->averageBrokenPairsDistanceClosest(params->config.nbClose),i });
+		ranking.push_back({ -getProximity(pop).averageBrokenPairsDistanceClosest(pop[i], params->config.nbClose),i });
 	}
 	std::sort(ranking.begin(), ranking.end());
 
@@ -279,7 +320,7 @@ void Population::removeWorstBiasedFitness(SubPopulation& pop)
 	for (int i = 1; i < static_cast<int>(pop.size()); i++)
 	{
 		// An averageBrokenPairsDistanceClosest equal to 0 indicates that a clone exists
-		bool isClone = (pop[i]->averageBrokenPairsDistanceClosest(1) < MY_EPSILON);
+		bool isClone = (getProximity(pop).averageBrokenPairsDistanceClosest(pop[i], 1) < MY_EPSILON);
 		if ((isClone && !isWorstIndividualClone) || (isClone == isWorstIndividualClone && pop[i]->biasedFitness > worstIndividualBiasedFitness))
 		{
 			worstIndividualBiasedFitness = pop[i]->biasedFitness;
@@ -291,8 +332,14 @@ void Population::removeWorstBiasedFitness(SubPopulation& pop)
 
 	// Remove the worst individual from the population
 	pop.erase(pop.begin() + worstIndividualPosition);
+	isBiasedFitnessOutdated(pop) = true;
 	// Cleaning its distances from the other individuals in the population
-	for (Individual* myIndividual2 : pop) myIndividual2->removeProximity(worstIndividual);
+	getProximity(pop).remove(worstIndividual);
+	auto edgeHashCount = edgeHashCounts.find(worstIndividual->edgeHash);
+	if (--edgeHashCount->second == 0)
+	{
+		edgeHashCounts.erase(edgeHashCount);
+	}
 	// Freeing memory
 	delete worstIndividual;
 }
@@ -312,6 +359,11 @@ void Population::restart()
 	// Clear the pools of solutions and make a new empty individual as the best solution after the restart
 	feasibleSubpopulation.clear();
 	infeasibleSubpopulation.clear();
+	feasibleProximity.clear();
+	infeasibleProximity.clear();
+	edgeHashCounts.clear();
+	isFeasibleBiasedFitnessOutdated = true;
+	isInfeasibleBiasedFitnessOutdated = true;
 	bestSolutionRestart = Individual();
 
 	// Generate a new initial population
@@ -367,6 +419,7 @@ void Population::managePenalties()
 				Individual* indiv = infeasibleSubpopulation[j];
 				infeasibleSubpopulation[j] = infeasibleSubpopulation[j + 1];
 				infeasibleSubpopulation[j + 1] = indiv;
+				isInfeasibleBiasedFitnessOutdated = true;
 			}
 		}
 	}
@@ -377,7 +430,7 @@ Individual* Population::getBinaryTournament()
 	Individual* individual1;
 	Individual* individual2;
 
-	// Update the fitness values of all the individuals (feasible and infeasible)
+	// Update the fitness values of all the individuals (feasible and infeasible), if a subpopulation changed since the last tournament
 	updateBiasedFitnesses(feasibleSubpopulation);
 	updateBiasedFitnesses(infeasibleSubpopulation);
 
@@ -414,6 +467,11 @@ Individual* Population::getBinaryTournament()
 	}
 }
 
+bool Population::hasClone(const Individual* indiv) const
+{
+	return edgeHashCounts.find(indiv->edgeHash) != edgeHashCounts.end();
+}
+
 std::pair<Individual*, Individual*> Population::getNonIdenticalParentsBinaryTournament()
 {
 	// Pick two individual using a binary tournament
@@ -461,8 +519,29 @@ Individual* Population::getBestFound()
 	else return nullptr;
 }
 
+std::vector<Individual*> Population::getBestIndividuals(int nbIndividuals)
+{
+	// Both subpopulations are ordered by increasing penalized cost, so take the first feasible individuals and complete with the first infeasible individuals
+	std::vector<Individual*> bestIndividuals;
+	for (int i = 0; i < static_cast<int>(feasibleSubpopulation.size()) && static_cast<int>(bestIndividuals.size()) < nbIndividuals; i++)
+	{
+		bestIndividuals.push_back(feasibleSubpopulation[i]);
+	}
+	for (int i = 0; i < static_cast<int>(infeasibleSubpopulation.size()) && static_cast<int>(bestIndividuals.size()) < nbIndividuals; i++)
+	{
+		bestIndividuals.push_back(infeasibleSubpopulation[i]);
+	}
+	return bestIndividuals;
+}
+
 void Population::printState(int nbIter, int nbIterNoImprovement)
 {
+	// With multiple islands, only the state of the first island is printed to keep the output readable
+	if (islandModel != nullptr && islandIdx > 0)
+	{
+		return;
+	}
+
 	// Print the number of iterations, the number of iterations since the last improvement, and the running time
 	std::printf("It %6d %6d | T(s) %.2f", nbIter, nbIterNoImprovement, params->getTimeElapsedSeconds());
 
@@ -490,6 +569,12 @@ void Population::printState(int nbIter, int nbIterNoImprovement)
 	std::printf(" | Div %.2f %.2f", getDiversity(feasibleSubpopulation), getDiversity(infeasibleSubpopulation));
 	std::printf(" | Feas %.2f %.2f", static_cast<double>(std::count(listFeasibilityLoad.begin(), listFeasibilityLoad.end(), true)) / static_cast<double>(listFeasibilityLoad.size()), static_cast<double>(std::count(listFeasibilityTimeWarp.begin(), listFeasibilityTimeWarp.end(), true)) / static_cast<double>(listFeasibilityTimeWarp.size()));
 	std::printf(" | Pen %.2f %.2f", params->penaltyCapacity, params->penaltyTimeWarp);
+
+	// If the local search cache is used, print the number of local searches found in the cache and the number of lookups
+	if (localSearchCache.isEnabled())
+	{
+		std::printf(" | Cache %lld/%lld", localSearchCache.getNbHits(), localSearchCache.getNbLookups());
+	}
 	std::cout << std::endl;
 }
 
@@ -503,7 +588,7 @@ double Population::getDiversity(const SubPopulation& pop)
 	int size = std::min(params->config.minimumPopulationSize, static_cast<int>(pop.size()));
 	for (int i = 0; i < size; i++)
 	{
-		average += pop[i]->averageBrokenPairsDistanceClosest(size);
+		average += getProximity(pop).averageBrokenPairsDistanceClosest(pop[i], size);
 	}
 
 	// Calculate the average and return if possible
@@ -625,7 +710,10 @@ void Population::logSolution(int nbIter, std::ofstream& myfile, Individual* indi
 	myfile << std::endl;
 }
 
-Population::Population(Params* params, Split* split, LocalSearch* localSearch) : params(params), split(split), localSearch(localSearch)
+Population::Population(Params* params, Split* split, LocalSearch* localSearch, IslandModel* islandModel, int islandIdx) : params(params), split(split), localSearch(localSearch), islandModel(islandModel), islandIdx(islandIdx),
+	feasibleProximity(params->config.nbClose, params->config.minimumPopulationSize + params->config.generationSize + 1),
+	infeasibleProximity(params->config.nbClose, params->config.minimumPopulationSize + params->config.generationSize + 1),
+	localSearchCache(params->config.localSearchCacheSize), isFeasibleBiasedFitnessOutdated(true), isInfeasibleBiasedFitnessOutdated(true)
 {
 	// Create lists for the load feasibility of the last 100 individuals generated by LS, where all feasibilities are set to true
 	listFeasibilityLoad = std::list<bool>(100, true);
@@ -24,17 +24,23 @@ SOFTWARE.*/
 #ifndef POPULATION_H
 #define POPULATION_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <list>
 #include <string>
 #include <time.h>
+#include <unordered_map>
 #include <vector>
 
 #include "Individual.h"
 #include "LocalSearch.h"
+#include "LocalSearchCache.h"
 #include "Params.h"
+#include "ProximityStructure.h"
 #include "Split.h"
 
+class IslandModel;
+
 // Create the alias SubPopulation for an object of type std::vector<Individual*>
 typedef std::vector<Individual*> SubPopulation;
 
@@ -52,8 +58,22 @@ private:
 	std::vector<std::pair<clock_t, double>> searchProgress; // Keeps tracks of the time stamps of successive best solutions
 	Individual bestSolutionRestart;							// Best solution found during the current restart of the algorthm
 	Individual bestSolutionOverall;							// Best solution found during the complete execution of the algorithm
-
-	// Evaluates the biased fitness of all individuals in the population
+	IslandModel* islandModel;								// Island model this population belongs to (nullptr if there is only one population)
+	int islandIdx;											// Index of the island of this population in the island model
+	ProximityStructure feasibleProximity;					// Distances between the individuals of the feasible subpopulation
+	ProximityStructure infeasibleProximity;					// Distances between the individuals of the infeasible subpopulation
+	LocalSearchCache localSearchCache;						// Results of previous local searches (only used if config.localSearchCacheSize > 0)
+	std::unordered_map<uint64_t, int> edgeHashCounts;		// Number of individuals in the population (feasible and infeasible) for each edge hash
+	bool isFeasibleBiasedFitnessOutdated;					// Tells whether the feasible subpopulation changed since its biased fitnesses were computed
+	bool isInfeasibleBiasedFitnessOutdated;					// Tells whether the infeasible subpopulation changed since its biased fitnesses were computed
+
+	// Accesses the proximity structure of the subpopulation pop
+	ProximityStructure& getProximity(const SubPopulation& pop);
+
+	// Accesses the flag telling whether the biased fitnesses of the subpopulation pop are outdated
+	bool& isBiasedFitnessOutdated(const SubPopulation& pop);
+
+	// Evaluates the biased fitness of all individuals in the population (only if the population changed since the last evaluation)
 	void updateBiasedFitnesses(SubPopulation& pop);
 
 	// Removes the worst individual in terms of biased fitness
@@ -69,6 +89,9 @@ public:
     // the construction heuristics through the parameters used.
     void generatePopulation();
 
+	// Runs the local search on indiv with the given penalties, or takes its result from the local search cache if it is there
+	void runLocalSearch(Individual* indiv, double penaltyCapacity, double penaltyTimeWarp);
+
 	// Add an individual in the population (survivor selection is automatically triggered whenever the population reaches its maximum size)
 	// Returns TRUE if a new best solution of the run has been found
 	bool addIndividual(const Individual* indiv, bool updateFeasible);
@@ -79,6 +102,9 @@ public:
 	// Adaptation of the penalty parameters (this also updates the evaluations)
 	void managePenalties();
 
+	// Tells whether an individual with the same edges as indiv (based on the edge hash) is in the population
+	bool hasClone(const Individual* indiv) const;
+
 	// Selects an individal by binary tournament
 	Individual* getBinaryTournament();
 
@@ -94,6 +120,9 @@ public:
 	// Accesses the best found solution at all time. If not possible, return nullptr
 	Individual* getBestFound();
 
+	// Accesses the nbIndividuals best individuals of the population, feasible individuals first
+	std::vector<Individual*> getBestIndividuals(int nbIndividuals);
+
 	// Prints population state
 	void printState(int nbIter, int nbIterNoImprovement);
 
@@ -117,8 +146,8 @@ public:
 	// Logs costs and list of client vists of one solution/individual to a file
 	void logSolution(int nbIter, std::ofstream& myfile, Individual* indiv);
 
-	// Constructor
-	Population(Params* params, Split* split, LocalSearch* localSearch);
+	// Constructor (islandModel and islandIdx are only given when the population is one of the islands of an IslandModel)
+	Population(Params* params, Split* split, LocalSearch* localSearch, IslandModel* islandModel = nullptr, int islandIdx = 0);
 
 	// Destructor
 	~Population();
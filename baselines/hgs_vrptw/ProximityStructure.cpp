@@ -0,0 +1,163 @@
+#include <algorithm>
+
+#include "Individual.h"
+#include "ProximityStructure.h"
+
+void ProximityStructure::grow(int newCapacity)
+{
+	// Copy the distances between the occupied slots to a matrix with the new number of columns
+	std::vector<double> newDistances(static_cast<size_t>(newCapacity) * newCapacity);
+	for (int slot1 : usedSlots)
+	{
+		for (int slot2 : usedSlots)
+		{
+			newDistances[static_cast<size_t>(slot1) * newCapacity + slot2] = distance(slot1, slot2);
+		}
+	}
+	distances = std::move(newDistances);
+	closest.resize(static_cast<size_t>(newCapacity) * nbClose);
+	closestSizes.resize(newCapacity);
+	usedSlots.reserve(newCapacity);
+	freeSlots.reserve(newCapacity);
+	buffer.resize(newCapacity);
+
+	// The new slots are free, and the slots with the lowest index are used first
+	for (int slot = newCapacity - 1; slot >= capacity; slot--)
+	{
+		freeSlots.push_back(slot);
+	}
+	capacity = newCapacity;
+}
+
+void ProximityStructure::insertClosest(int slot, int other, double dist)
+{
+	std::pair<double, int>* list = &closest[static_cast<size_t>(slot) * nbClose];
+	int position;
+	if (closestSizes[slot] < nbClose)
+	{
+		position = closestSizes[slot]++;
+	}
+	else if (dist < list[nbClose - 1].first)
+	{
+		position = nbClose - 1;
+	}
+	else
+	{
+		return;
+	}
+
+	// Shift the farther slots to keep the list in increasing order of distance
+	while (position > 0 && list[position - 1].first > dist)
+	{
+		list[position] = list[position - 1];
+		position--;
+	}
+	list[position] = { dist, other };
+}
+
+void ProximityStructure::rebuildClosest(int slot)
+{
+	int size = 0;
+	for (int other : usedSlots)
+	{
+		if (other != slot)
+		{
+			buffer[size++] = { distance(slot, other), other };
+		}
+	}
+	closestSizes[slot] = std::min(nbClose, size);
+	std::partial_sort_copy(buffer.begin(), buffer.begin() + size, closest.begin() + static_cast<size_t>(slot) * nbClose,
+		closest.begin() + static_cast<size_t>(slot) * nbClose + closestSizes[slot]);
+}
+
+void ProximityStructure::add(Individual* indiv, const std::vector<Individual*>& subpop)
+{
+	if (freeSlots.empty())
+	{
+		grow(2 * capacity);
+	}
+	int slot = freeSlots.back();
+	freeSlots.pop_back();
+	indiv->proximitySlot = slot;
+	closestSizes[slot] = 0;
+	distance(slot, slot) = 0.;
+
+	// Calculate the distances to the other individuals and update the lists of closest individuals on both sides
+	for (Individual* indiv2 : subpop)
+	{
+		int slot2 = indiv2->proximitySlot;
+		double dist = indiv->brokenPairsDistance(indiv2);
+		distance(slot, slot2) = dist;
+		distance(slot2, slot) = dist;
+		insertClosest(slot, slot2, dist);
+		insertClosest(slot2, slot, dist);
+	}
+	usedSlots.push_back(slot);
+}
+
+void ProximityStructure::remove(Individual* indiv)
+{
+	int slot = indiv->proximitySlot;
+	usedSlots.erase(std::find(usedSlots.begin(), usedSlots.end(), slot));
+	freeSlots.push_back(slot);
+	indiv->proximitySlot = -1;
+
+	// Only the individuals that had indiv among their closest individuals need to recompute their list
+	for (int other : usedSlots)
+	{
+		auto first = closest.begin() + static_cast<size_t>(other) * nbClose;
+		auto last = first + closestSizes[other];
+		if (std::find_if(first, last, [slot](const std::pair<double, int>& element) { return element.second == slot; }) != last)
+		{
+			rebuildClosest(other);
+		}
+	}
+}
+
+void ProximityStructure::clear()
+{
+	usedSlots.clear();
+	freeSlots.clear();
+	for (int slot = capacity - 1; slot >= 0; slot--)
+	{
+		freeSlots.push_back(slot);
+	}
+}
+
+double ProximityStructure::averageBrokenPairsDistanceClosest(const Individual* indiv, int nbClosest)
+{
+	int slot = indiv->proximitySlot;
+	int maxSize = std::min(nbClosest, static_cast<int>(usedSlots.size()) - 1);
+	double result = 0.;
+	if (maxSize <= closestSizes[slot])
+	{
+		// The closest individuals are in the list of the slot
+		for (int i = 0; i < maxSize; i++)
+		{
+			result += closest[static_cast<size_t>(slot) * nbClose + i].first;
+		}
+	}
+	else
+	{
+		// More individuals than kept in the list are needed (only when monitoring the diversity), select them from the distance matrix
+		int size = 0;
+		for (int other : usedSlots)
+		{
+			if (other != slot)
+			{
+				buffer[size++] = { distance(slot, other), other };
+			}
+		}
+		std::partial_sort(buffer.begin(), buffer.begin() + maxSize, buffer.begin() + size);
+		for (int i = 0; i < maxSize; i++)
+		{
+			result += buffer[i].first;
+		}
+	}
+	return result / maxSize;
+}
+
+ProximityStructure::ProximityStructure(int nbClose, int capacity) : nbClose(std::max(nbClose, 1)), capacity(0)
+{
+	grow(std::max(capacity, 1));
+}
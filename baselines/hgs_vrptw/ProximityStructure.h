@@ -0,0 +1,79 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#ifndef PROXIMITYSTRUCTURE_H
+#define PROXIMITYSTRUCTURE_H
+
+#include <utility>
+#include <vector>
+
+class Individual;
+
+// Broken pairs distances between the individuals of a subpopulation. Each individual in the subpopulation occupies a slot, and the
+// distances are kept in a matrix over the slots. For each slot, the nbClose closest other individuals are kept in a sorted list, such
+// that the diversity contribution of an individual is available without walking the distances to all other individuals.
+// The storage is allocated for a given number of slots and only grows if the subpopulation becomes larger than that
+class ProximityStructure
+{
+private:
+	int nbClose;											// Number of closest individuals kept per slot (at least 1, to detect clones)
+	int capacity;											// Number of slots for which the storage is allocated
+	std::vector<double> distances;							// Distance between the individuals in two slots, in a capacity by capacity matrix
+	std::vector<std::pair<double, int>> closest;			// For each slot, the nbClose closest (distance, slot) pairs in increasing order of distance
+	std::vector<int> closestSizes;							// For each slot, the number of elements in its list of closest slots
+	std::vector<int> usedSlots;								// Slots occupied by an individual
+	std::vector<int> freeSlots;								// Slots not occupied by an individual
+	std::vector<std::pair<double, int>> buffer;				// Buffer to select the closest slots of a slot, of size capacity
+
+	// Distance between the individuals in the slots slot1 and slot2
+	double& distance(int slot1, int slot2) { return distances[static_cast<size_t>(slot1) * capacity + slot2]; }
+
+	// Increases the number of slots to newCapacity, keeping the distances between the occupied slots
+	void grow(int newCapacity);
+
+	// Inserts the slot other at the given distance in the list of closest slots of slot, if it is among the nbClose closest
+	void insertClosest(int slot, int other, double dist);
+
+	// Recomputes the list of closest slots of slot from the distance matrix
+	void rebuildClosest(int slot);
+
+public:
+	// Adds indiv to the structure, computing its distances to the individuals in subpop (which does not contain indiv yet).
+	// The slot of indiv is stored in indiv->proximitySlot
+	void add(Individual* indiv, const std::vector<Individual*>& subpop);
+
+	// Removes indiv from the structure, and frees its slot
+	void remove(Individual* indiv);
+
+	// Removes all individuals from the structure
+	void clear();
+
+	// Returns the average distance of indiv with its nbClosest closest individuals (NaN if indiv is the only individual)
+	double averageBrokenPairsDistanceClosest(const Individual* indiv, int nbClosest);
+
+	// Constructor: structure keeping the nbClose closest individuals, with storage for capacity individuals
+	ProximityStructure(int nbClose, int capacity);
+};
+
+#endif
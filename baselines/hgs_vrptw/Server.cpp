@@ -0,0 +1,232 @@
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Server.h"
+#include "commandline.h"
+#include "Params.h"
+#include "InstanceData.h"
+#include "Population.h"
+#include "Genetic.h"
+#include "IslandModel.h"
+
+void Server::run()
+{
+	if (socketPath.empty())
+	{
+		// Requests are read from stdin (file descriptor 0)
+		serveConnection(0);
+		return;
+	}
+
+#ifdef _WIN32
+	throw std::string("Server mode with a socket is not supported on Windows");
+#else
+	// A client closing its connection before the end of a response should not terminate the server
+	std::signal(SIGPIPE, SIG_IGN);
+
+	// Create the socket and listen for clients, one at a time
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0 || socketPath.size() >= sizeof(address.sun_path))
+	{
+		throw std::string("Impossible to create socket: " + socketPath);
+	}
+	socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+	unlink(socketPath.c_str());
+	if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, 1) < 0)
+	{
+		throw std::string("Impossible to listen on socket: " + socketPath);
+	}
+	std::cout << "----- SERVER LISTENING ON " << socketPath << std::endl;
+
+	// The responses are written to stdout, so stdout is redirected to the connection of the current client
+	int stdoutFd = dup(STDOUT_FILENO);
+	while (true)
+	{
+		int connectionFd = accept(listenFd, nullptr, nullptr);
+		if (connectionFd < 0)
+		{
+			continue;
+		}
+		std::cout << std::flush;
+		fflush(stdout);
+		dup2(connectionFd, STDOUT_FILENO);
+		serveConnection(connectionFd);
+
+		// Restore stdout (writing may have failed if the client disconnected)
+		std::cout << std::flush;
+		fflush(stdout);
+		dup2(stdoutFd, STDOUT_FILENO);
+		std::cout.clear();
+		close(connectionFd);
+	}
+#endif
+}
+
+void Server::serveConnection(int fd)
+{
+	std::string message;
+	while (readMessage(fd, message))
+	{
+		// An invalid request is reported to the client, but does not terminate the server
+		try
+		{
+			solve(message);
+		}
+		catch (const std::string& e)
+		{
+			std::cout << "EXCEPTION | " << e << std::endl;
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "EXCEPTION | " << e.what() << std::endl;
+		}
+		std::cout << "----- REQUEST FINISHED" << std::endl;
+	}
+}
+
+bool Server::readMessage(int fd, std::string& message)
+{
+	// Read the length of the message (4 bytes, little endian)
+	unsigned char header[4];
+	if (!readBytes(fd, reinterpret_cast<char*>(header), 4))
+	{
+		return false;
+	}
+	uint32_t length = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<uint32_t>(header[3]) << 24);
+
+	// Read the message itself
+	message.resize(length);
+	if (!readBytes(fd, message.data(), length))
+	{
+		throw std::string("Input ended in the middle of a request");
+	}
+	return true;
+}
+
+bool Server::readBytes(int fd, char* buffer, size_t size)
+{
+	size_t nbRead = 0;
+	while (nbRead < size)
+	{
+#ifdef _WIN32
+		int result = _read(fd, buffer + nbRead, static_cast<unsigned int>(size - nbRead));
+#else
+		ssize_t result = read(fd, buffer + nbRead, size - nbRead);
+#endif
+		if (result <= 0)
+		{
+			return false;
+		}
+		nbRead += result;
+	}
+	return true;
+}
+
+void Server::solve(const std::string& message)
+{
+	// The arguments (one per line) are separated from the instance by an empty line
+	size_t endArguments = message.find("\n\n");
+	if (endArguments == std::string::npos)
+	{
+		throw std::string("Request without an empty line between the arguments and the instance");
+	}
+
+	// Parse the arguments as if they were given on the command line, after the instance and solution paths
+	std::vector<std::string> arguments = { "genvrp", "request", "request.sol" };
+	std::istringstream argumentStream(message.substr(0, endArguments));
+	for (std::string line; std::getline(argumentStream, line);)
+	{
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		arguments.push_back(line);
+	}
+	std::vector<char*> argv;
+	for (std::string& argument : arguments)
+	{
+		argv.push_back(argument.data());
+	}
+	CommandLine commandline(static_cast<int>(argv.size()), argv.data());
+	if (commandline.config.timeLimit == INT_MAX)
+	{
+		throw std::string("A time limit (-t) is required for every request in server mode");
+	}
+
+	// Every new best solution is written to stdout, as in a DIMACS run
+	commandline.config.isDimacsRun = true;
+
+	// Read the instance from the message
+	std::string_view instanceText = std::string_view(message).substr(endArguments + 2);
+	Params params(commandline.config, InstanceData::fromText(instanceText, commandline.config.nbVeh, commandline.config.reorderClients));
+	std::cout << "----- INSTANCE LOADED WITH " << params.nbClients << " CLIENTS AND " << params.nbVehicles << " VEHICLES" << std::endl;
+
+	if (params.config.nbThreads > 1)
+	{
+		// The islands have their own Split and Local Search structures
+		IslandModel islandModel(&params, params.config.nbThreads);
+		islandModel.run(params.config.nbIter, params.config.timeLimit);
+	}
+	else
+	{
+		// Reuse the Split and Local Search structures of the previous requests
+		if (split == nullptr)
+		{
+			// With an unlimited fleet, the number of vehicles equals the number of clients
+			split = std::make_unique<Split>(&params);
+			localSearch = std::make_unique<LocalSearch>(&params);
+			split->reserve(maxClients, maxClients);
+			localSearch->reserve(maxClients, maxClients);
+		}
+		split->reinitialize(&params);
+		localSearch->reinitialize(&params);
+
+		Population population(&params, split.get(), localSearch.get());
+		Genetic solver(&params, split.get(), &population, localSearch.get());
+		solver.run(params.config.nbIter, params.config.timeLimit);
+	}
+	std::cout << "----- GENETIC ALGORITHM FINISHED, TIME SPENT: " << params.getTimeElapsedSeconds() << std::endl;
+}
+
+Server::Server(int argc, char* argv[]) : maxClients(0)
+{
+	// Arguments after --serve, counted as 2 per argument
+	for (int i = 2; i < argc; i += 2)
+	{
+		if (i + 1 >= argc)
+		{
+			throw std::string("Missing value for argument: " + std::string(argv[i]));
+		}
+		else if (std::string(argv[i]) == "-socket")
+		{
+			socketPath = std::string(argv[i + 1]);
+		}
+		else if (std::string(argv[i]) == "-maxClients")
+		{
+			maxClients = atoi(argv[i + 1]);
+		}
+		else
+		{
+			throw std::string("Argument not recognized in server mode: " + std::string(argv[i]));
+		}
+	}
+}
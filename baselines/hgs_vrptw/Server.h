@@ -0,0 +1,71 @@
+/*MIT License
+
+Original HGS-CVRP code: Copyright(c) 2020 Thibaut Vidal
+Additional contributions: Copyright(c) 2022 ORTEC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "Split.h"
+#include "LocalSearch.h"
+
+// Class to run the algorithm as a persistent process (genvrp --serve), solving one instance per request.
+// The Split and LocalSearch structures are kept alive between requests, so that their memory is only allocated once.
+//
+// A request is a 4-byte little-endian length, followed by a message of that length:
+//		- the command line arguments of the run, one per line (e.g. "-t", "10", "-seed", "1", "-veh", "-1"), where a time limit is required
+//		- an empty line
+//		- the instance, in the same format as an instance file
+// Every new best solution of the run is written to the output (as in a DIMACS run), and the line "----- REQUEST FINISHED" ends the response.
+// Requests are read from stdin (responses written to stdout), or from the clients connecting to a UNIX socket (not available on Windows).
+class Server
+{
+public:
+	// Serves all requests until the end of the input (stdin) or forever (socket)
+	void run();
+
+	// Constructor, reading the arguments of the server: genvrp --serve [-socket socketPath] [-maxClients nbClients]
+	Server(int argc, char* argv[]);
+
+private:
+	std::string socketPath;						// Path of the UNIX socket to listen on (empty to read the requests from stdin)
+	int maxClients;								// Number of clients for which the memory is allocated at the first request (otherwise, the memory grows with the largest instance)
+	std::unique_ptr<Split> split;				// Split structure, reused for all requests
+	std::unique_ptr<LocalSearch> localSearch;	// Local search structure, reused for all requests
+
+	// Serves all requests read from the file descriptor fd, until the end of the input
+	void serveConnection(int fd);
+
+	// Reads a request from the file descriptor fd in message. Returns FALSE at the end of the input
+	bool readMessage(int fd, std::string& message);
+
+	// Reads exactly size bytes from the file descriptor fd in buffer. Returns FALSE if the input ends before
+	bool readBytes(int fd, char* buffer, size_t size);
+
+	// Solves the instance of a request, writing the solutions to stdout
+	void solve(const std::string& message);
+};
+
+#endif
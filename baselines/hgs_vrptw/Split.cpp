@@ -272,13 +272,48 @@ int Split::splitLF(Individual* indiv)
 	return (end == 0);
 }
 
-Split::Split(Params* params) : params(params)
+void Split::reinitialize(Params* params)
 {
 	// Initialize structures for the Linear Split
-	cliSplit = std::vector<ClientSplit>(params->nbClients + 1);
-	sumDistance = std::vector<int>(params->nbClients + 1, 0);
-	sumLoad = std::vector<int>(params->nbClients + 1, 0);
-	sumService = std::vector<int>(params->nbClients + 1, 0);
-	potential = std::vector<std::vector<double>>(params->nbVehicles + 1, std::vector<double>(params->nbClients + 1, 1.e30));
-	pred = std::vector<std::vector<int>>(params->nbVehicles + 1, std::vector<int>(params->nbClients + 1, 0));
+	// All vectors are resized with assign, which keeps their allocated memory, such that a Split can be reused for other instances
+	this->params = params;
+	cliSplit.assign(params->nbClients + 1, ClientSplit());
+	sumDistance.assign(params->nbClients + 1, 0);
+	sumLoad.assign(params->nbClients + 1, 0);
+	sumService.assign(params->nbClients + 1, 0);
+
+	// The outer vectors of potential and pred never shrink, to keep the memory of the inner vectors (only the first nbVehicles + 1 are used)
+	if (static_cast<int>(potential.size()) < params->nbVehicles + 1)
+	{
+		potential.resize(params->nbVehicles + 1);
+		pred.resize(params->nbVehicles + 1);
+	}
+	for (int k = 0; k <= params->nbVehicles; k++)
+	{
+		potential[k].assign(params->nbClients + 1, 1.e30);
+		pred[k].assign(params->nbClients + 1, 0);
+	}
+}
+
+void Split::reserve(int maxClients, int maxVehicles)
+{
+	cliSplit.reserve(maxClients + 1);
+	sumDistance.reserve(maxClients + 1);
+	sumLoad.reserve(maxClients + 1);
+	sumService.reserve(maxClients + 1);
+	if (static_cast<int>(potential.size()) < maxVehicles + 1)
+	{
+		potential.resize(maxVehicles + 1);
+		pred.resize(maxVehicles + 1);
+	}
+	for (int k = 0; k <= maxVehicles; k++)
+	{
+		potential[k].reserve(maxClients + 1);
+		pred[k].reserve(maxClients + 1);
+	}
+}
+
+Split::Split(Params* params)
+{
+	reinitialize(params);
 }
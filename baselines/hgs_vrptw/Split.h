@@ -158,6 +158,13 @@ public:
 	// General Split function (tests the unlimited fleet, and only if it does not produce a feasible solution, runs the Split algorithm for limited fleet)
 	void generalSplit(Individual* indiv, int nbMaxVehicles);
 
+	// Prepares the data structures for the instance of params, reusing the memory that was already allocated
+	void reinitialize(Params* params);
+
+	// Allocates memory for instances with up to maxClients clients and maxVehicles vehicles, such that reinitialize does not need to allocate
+	// Attention: reinitialize should be called afterwards, since the data structures may be moved in memory
+	void reserve(int maxClients, int maxVehicles);
+
 	// Constructor
 	Split(Params* params);
 };
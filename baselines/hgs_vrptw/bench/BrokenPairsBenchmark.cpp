@@ -0,0 +1,106 @@
+// Micro-benchmark of the broken pairs distance between individuals (Individual::brokenPairsDistance), against the original
+// implementation with a branch per client. The distances are computed between all pairs of a set of local optima of the instance, which
+// are similar to the individuals of a population, and both implementations are checked to give the same distances.
+// Compile with -mavx2 (see the Makefile) to measure the AVX2 version instead of the SSE2 version.
+// Usage: ./bench_brokenpairs [instancePath] [nbIndividuals] [nbRepeats]
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Individual.h"
+#include "../InstanceData.h"
+#include "../LocalSearch.h"
+#include "../Params.h"
+#include "../Split.h"
+
+// Original implementation of the broken pairs distance, with a branch per client and per type of arc
+double brokenPairsDistanceReference(const Params& params, const Individual& indiv1, const Individual& indiv2)
+{
+	int differences = 0;
+	for (int j = 1; j <= params.nbClients; j++)
+	{
+		if (indiv1.successors[j] != indiv2.successors[j] && indiv1.successors[j] != indiv2.predecessors[j])
+		{
+			differences++;
+		}
+		if (indiv1.predecessors[j] == 0 && indiv2.predecessors[j] != 0 && indiv2.successors[j] != 0)
+		{
+			differences++;
+		}
+	}
+	return static_cast<double>(differences) / params.nbClients;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = argc > 1 ? argv[1] : "../../instances/ORTEC-VRPTW-ASYM-dd43a785-d1-n880-k50.txt";
+	int nbIndividuals = argc > 2 ? std::stoi(argv[2]) : 50;
+	int nbRepeats = argc > 3 ? std::stoi(argv[3]) : 20;
+
+	Params::Config config;
+	config.seed = 1;
+	config.isDimacsRun = true;
+	Params params(config, std::make_shared<const InstanceData>(path, INT_MAX));
+	Split split(&params);
+	LocalSearch localSearch(&params);
+
+	// Local optima of random solutions
+	std::vector<Individual> individuals;
+	for (int i = 0; i < nbIndividuals; i++)
+	{
+		Individual indiv(&params);
+		split.generalSplit(&indiv, params.nbVehicles);
+		localSearch.run(&indiv, params.penaltyCapacity, params.penaltyTimeWarp);
+		individuals.push_back(indiv);
+	}
+
+	// Time both implementations on all ordered pairs of individuals
+	double sumReference = 0.;
+	double sumVectorized = 0.;
+	int nbMismatches = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < nbRepeats; r++)
+	{
+		for (Individual& indiv1 : individuals)
+		{
+			for (Individual& indiv2 : individuals)
+			{
+				sumReference += brokenPairsDistanceReference(params, indiv1, indiv2);
+			}
+		}
+	}
+	auto middle = std::chrono::steady_clock::now();
+	for (int r = 0; r < nbRepeats; r++)
+	{
+		for (Individual& indiv1 : individuals)
+		{
+			for (Individual& indiv2 : individuals)
+			{
+				sumVectorized += indiv1.brokenPairsDistance(&indiv2);
+			}
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	for (Individual& indiv1 : individuals)
+	{
+		for (Individual& indiv2 : individuals)
+		{
+			if (indiv1.brokenPairsDistance(&indiv2) != brokenPairsDistanceReference(params, indiv1, indiv2))
+			{
+				nbMismatches++;
+			}
+		}
+	}
+
+	long long nbDistances = static_cast<long long>(nbRepeats) * nbIndividuals * nbIndividuals;
+	double secondsReference = std::chrono::duration<double>(middle - start).count();
+	double secondsVectorized = std::chrono::duration<double>(end - middle).count();
+	std::cout << "----- " << nbDistances << " BROKEN PAIRS DISTANCES BETWEEN " << nbIndividuals << " LOCAL OPTIMA (" << path << ", " << params.nbClients << " clients)" << std::endl;
+	std::cout << "Reference:   " << secondsReference * 1.e9 / nbDistances << " ns/distance (average distance " << sumReference / nbDistances << ")" << std::endl;
+	std::cout << "Vectorized:  " << secondsVectorized * 1.e9 / nbDistances << " ns/distance (average distance " << sumVectorized / nbDistances << ")" << std::endl;
+	std::cout << "Speedup:     " << secondsReference / secondsVectorized << std::endl;
+	std::cout << "Mismatches:  " << nbMismatches << std::endl;
+	return nbMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+// Micro-benchmark of the local search with the clients numbered as in the instance file, and with the clients reordered along
+// a space filling curve (InstanceData::reorderClients). For both numberings, the local search is run on the same number of random
+// solutions (with the same seed), and the number of moves applied per second is reported. As the numbering changes the random
+// solutions and the order in which the moves are evaluated, the average cost of the local optima is reported as a sanity check.
+// The instance path can also be a directory, in which case the results are summed over all instance files (*.txt) in the directory.
+// Running this benchmark before and after a change of the local search gives the change in moves per second (in file order)
+// Usage: ./bench_localsearch [instancePath or instanceDirectory] [nbRuns]
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Individual.h"
+#include "../InstanceData.h"
+#include "../LocalSearch.h"
+#include "../Params.h"
+#include "../Split.h"
+
+// Result of running the local search nbRuns times on one numbering of the instance
+struct LocalSearchResult
+{
+	double seconds = 0.;		// Time spent in the local search
+	long long nbMoves = 0;		// Total number of moves applied
+	double totalCost = 0.;		// Sum of the penalized costs of the local optima
+};
+
+LocalSearchResult runLocalSearch(const std::string& path, bool isReorderClients, int nbRuns)
+{
+	Params::Config config;
+	config.seed = 1;
+	config.isDimacsRun = true;
+	Params params(config, std::make_shared<const InstanceData>(path, INT_MAX, isReorderClients));
+	Split split(&params);
+	LocalSearch localSearch(&params);
+
+	LocalSearchResult result;
+	for (int r = 0; r < nbRuns; r++)
+	{
+		Individual indiv(&params);
+		split.generalSplit(&indiv, params.nbVehicles);
+		auto start = std::chrono::steady_clock::now();
+		localSearch.run(&indiv, params.penaltyCapacity, params.penaltyTimeWarp);
+		auto end = std::chrono::steady_clock::now();
+		result.seconds += std::chrono::duration<double>(end - start).count();
+		result.nbMoves += localSearch.getNbMoves();
+		result.totalCost += indiv.myCostSol.penalizedCost;
+	}
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = argc > 1 ? argv[1] : "../../instances";
+	int nbRuns = argc > 2 ? std::stoi(argv[2]) : 5;
+
+	std::vector<std::string> paths;
+	if (std::filesystem::is_directory(path))
+	{
+		for (const auto& entry : std::filesystem::directory_iterator(path))
+		{
+			if (entry.path().extension() == ".txt")
+			{
+				paths.push_back(entry.path().string());
+			}
+		}
+		std::sort(paths.begin(), paths.end());
+	}
+	else
+	{
+		paths.push_back(path);
+	}
+
+	LocalSearchResult fileOrder;
+	LocalSearchResult reordered;
+	for (const std::string& instancePath : paths)
+	{
+		LocalSearchResult result = runLocalSearch(instancePath, false, nbRuns);
+		fileOrder.seconds += result.seconds;
+		fileOrder.nbMoves += result.nbMoves;
+		fileOrder.totalCost += result.totalCost;
+		result = runLocalSearch(instancePath, true, nbRuns);
+		reordered.seconds += result.seconds;
+		reordered.nbMoves += result.nbMoves;
+		reordered.totalCost += result.totalCost;
+	}
+
+	int nbSolutions = nbRuns * static_cast<int>(paths.size());
+	std::cout << "----- LOCAL SEARCH ON " << nbRuns << " RANDOM SOLUTIONS OF " << paths.size() << " INSTANCES (" << path << ")" << std::endl;
+	std::cout << "File order:  " << fileOrder.nbMoves / fileOrder.seconds << " moves/s, "
+		<< fileOrder.seconds * 1000. << " ms, " << fileOrder.nbMoves << " moves, average cost " << fileOrder.totalCost / nbSolutions << std::endl;
+	std::cout << "Reordered:   " << reordered.nbMoves / reordered.seconds << " moves/s, "
+		<< reordered.seconds * 1000. << " ms, " << reordered.nbMoves << " moves, average cost " << reordered.totalCost / nbSolutions << std::endl;
+	std::cout << "Speedup:     " << (reordered.nbMoves / reordered.seconds) / (fileOrder.nbMoves / fileOrder.seconds) << std::endl;
+	return 0;
+}
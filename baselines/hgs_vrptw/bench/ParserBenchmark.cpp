@@ -0,0 +1,105 @@
+// Micro-benchmark of the instance parsers: the original parser based on stream extraction (InstanceData::readTextStream)
+// against the parser tokenizing the whole file in place with std::from_chars (InstanceData::readText).
+// Both parsers are run on all instance files (*.txt) of a directory, and their results are checked to be identical.
+// Usage: ./bench_parser [instanceDirectory] [nbRepetitions]
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../InstanceData.h"
+
+// Reads the whole file at path in a string
+std::string readFile(const std::string& path)
+{
+	std::ifstream inputFile(path, std::ios::binary | std::ios::ate);
+	std::string buffer(static_cast<size_t>(inputFile.tellg()), '\0');
+	inputFile.seekg(0);
+	inputFile.read(buffer.data(), buffer.size());
+	return buffer;
+}
+
+// Checks that two parsed instances contain the same data
+bool isSameInstance(const InstanceData& a, const InstanceData& b)
+{
+	if (a.nbClients != b.nbClients || a.vehicleCapacity != b.vehicleCapacity || a.nbVehicles != b.nbVehicles || a.totalDemand != b.totalDemand
+		|| a.maxDemand != b.maxDemand || a.isTimeWindowConstraint != b.isTimeWindowConstraint || a.isExplicitDistanceMatrix != b.isExplicitDistanceMatrix)
+	{
+		return false;
+	}
+	for (int i = 0; i <= a.nbClients; i++)
+	{
+		const Client& ca = a.cli[i];
+		const Client& cb = b.cli[i];
+		if (ca.coordX != cb.coordX || ca.coordY != cb.coordY || ca.demand != cb.demand || ca.serviceDuration != cb.serviceDuration
+			|| ca.earliestArrival != cb.earliestArrival || ca.latestArrival != cb.latestArrival || ca.polarAngle != cb.polarAngle)
+		{
+			return false;
+		}
+		for (int j = 0; a.isExplicitDistanceMatrix && j <= a.nbClients; j++)
+		{
+			if (a.timeCost.get(i, j) != b.timeCost.get(i, j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string directory = argc > 1 ? argv[1] : "../../instances";
+	int nbRepetitions = argc > 2 ? std::stoi(argv[2]) : 3;
+
+	std::vector<std::string> paths;
+	for (const auto& entry : std::filesystem::directory_iterator(directory))
+	{
+		if (entry.path().extension() == ".txt")
+		{
+			paths.push_back(entry.path().string());
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+
+	// For each parser, the best time over the repetitions is kept (per instance), including reading the file
+	double totalStream = 0.;
+	double totalFromChars = 0.;
+	int nbMismatches = 0;
+	for (const std::string& path : paths)
+	{
+		double bestStream = 1.e30;
+		double bestFromChars = 1.e30;
+		for (int r = 0; r < nbRepetitions; r++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			InstanceData stream;
+			std::ifstream inputFile(path);
+			stream.readTextStream(inputFile);
+			auto middle = std::chrono::steady_clock::now();
+			InstanceData fromChars;
+			fromChars.readText(readFile(path));
+			auto end = std::chrono::steady_clock::now();
+
+			bestStream = std::min(bestStream, std::chrono::duration<double>(middle - start).count());
+			bestFromChars = std::min(bestFromChars, std::chrono::duration<double>(end - middle).count());
+			if (r == 0 && !isSameInstance(stream, fromChars))
+			{
+				std::cout << "MISMATCH between the parsers for instance " << path << std::endl;
+				nbMismatches++;
+			}
+		}
+		totalStream += bestStream;
+		totalFromChars += bestFromChars;
+	}
+
+	std::cout << "----- PARSED " << paths.size() << " INSTANCES FROM " << directory << " (BEST OF " << nbRepetitions << " REPETITIONS)" << std::endl;
+	std::cout << "Stream extraction parser: " << totalStream * 1000. << " ms" << std::endl;
+	std::cout << "from_chars parser:        " << totalFromChars * 1000. << " ms" << std::endl;
+	std::cout << "Speedup:                  " << totalStream / totalFromChars << std::endl;
+	std::cout << "Mismatches:               " << nbMismatches << std::endl;
+	return nbMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Micro-benchmark of the time window data of route segments in the local search: seeds every 4 nodes (default) against a segment
+// tree per route (config.useRouteSegmentTree). For every instance, the local search is run on the same random solutions with both
+// approaches, which give the same local optima. The results are grouped by the average number of clients per route in the local optima,
+// to show from which route length the segment tree is faster.
+// Usage: ./bench_routesegment [instancePath or instanceDirectory] [nbRuns]
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Individual.h"
+#include "../InstanceData.h"
+#include "../LocalSearch.h"
+#include "../Params.h"
+#include "../Split.h"
+
+// Result of running the local search nbRuns times with one of the approaches
+struct RouteSegmentResult
+{
+	double seconds = 0.;		// Time spent in the local search
+	long long nbMoves = 0;		// Total number of moves applied
+	int nbClients = 0;			// Total number of clients in the local optima
+	int nbRoutes = 0;			// Total number of (non-empty) routes in the local optima
+	int nbInstances = 0;		// Number of instances (when summing results over instances)
+};
+
+RouteSegmentResult runLocalSearch(std::shared_ptr<const InstanceData> instance, bool useRouteSegmentTree, int nbRuns)
+{
+	Params::Config config;
+	config.seed = 1;
+	config.isDimacsRun = true;
+	config.useRouteSegmentTree = useRouteSegmentTree;
+	Params params(config, instance);
+	Split split(&params);
+	LocalSearch localSearch(&params);
+
+	RouteSegmentResult result;
+	for (int r = 0; r < nbRuns; r++)
+	{
+		Individual indiv(&params);
+		split.generalSplit(&indiv, params.nbVehicles);
+		auto start = std::chrono::steady_clock::now();
+		localSearch.run(&indiv, params.penaltyCapacity, params.penaltyTimeWarp);
+		auto end = std::chrono::steady_clock::now();
+		result.seconds += std::chrono::duration<double>(end - start).count();
+		result.nbMoves += localSearch.getNbMoves();
+		result.nbClients += params.nbClients;
+		result.nbRoutes += indiv.myCostSol.nbRoutes;
+	}
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = argc > 1 ? argv[1] : "../../instances";
+	int nbRuns = argc > 2 ? std::stoi(argv[2]) : 5;
+
+	std::vector<std::string> paths;
+	if (std::filesystem::is_directory(path))
+	{
+		for (const auto& entry : std::filesystem::directory_iterator(path))
+		{
+			if (entry.path().extension() == ".txt")
+			{
+				paths.push_back(entry.path().string());
+			}
+		}
+		std::sort(paths.begin(), paths.end());
+	}
+	else
+	{
+		paths.push_back(path);
+	}
+
+	// Results by group of 5 clients per route (key 10 contains the instances with 10 to 14 clients per route)
+	std::map<int, std::pair<RouteSegmentResult, RouteSegmentResult>> resultsByRouteLength;
+	int nbMismatches = 0;
+	for (const std::string& instancePath : paths)
+	{
+		auto instance = std::make_shared<const InstanceData>(instancePath, INT_MAX);
+		RouteSegmentResult seeds = runLocalSearch(instance, false, nbRuns);
+		RouteSegmentResult tree = runLocalSearch(instance, true, nbRuns);
+		if (seeds.nbMoves != tree.nbMoves)
+		{
+			std::cout << "MISMATCH between the approaches for instance " << instancePath << std::endl;
+			nbMismatches++;
+		}
+		int routeLength = 5 * (seeds.nbClients / std::max(seeds.nbRoutes, 1) / 5);
+		auto& [totalSeeds, totalTree] = resultsByRouteLength[routeLength];
+		totalSeeds.seconds += seeds.seconds;
+		totalSeeds.nbMoves += seeds.nbMoves;
+		totalTree.seconds += tree.seconds;
+		totalTree.nbMoves += tree.nbMoves;
+		totalSeeds.nbInstances++;
+	}
+
+	std::cout << "----- LOCAL SEARCH ON " << nbRuns << " RANDOM SOLUTIONS OF " << paths.size() << " INSTANCES (" << path << ")" << std::endl;
+	std::cout << "Clients/route  Instances  Seeds (moves/s)  Segment tree (moves/s)  Speedup" << std::endl;
+	for (const auto& [routeLength, results] : resultsByRouteLength)
+	{
+		double seedsSpeed = results.first.nbMoves / results.first.seconds;
+		double treeSpeed = results.second.nbMoves / results.second.seconds;
+		std::cout << routeLength << "-" << routeLength + 4 << "\t\t" << results.first.nbInstances << "\t\t" << seedsSpeed << "\t\t" << treeSpeed << "\t\t\t" << treeSpeed / seedsSpeed << std::endl;
+	}
+	std::cout << "Mismatches: " << nbMismatches << std::endl;
+	return nbMismatches == 0 ? 0 : 1;
+}
@@ -117,6 +117,8 @@ public:
 					config.useSymmetricCorrelatedVertices = atoi(argv[i + 1]) != 0;
 				else if (std::string(argv[i]) == "-doRepeatUntilTimeLimit")
 					config.doRepeatUntilTimeLimit = atoi(argv[i + 1]) != 0;
+				else if (std::string(argv[i]) == "-reorderClients")
+					config.reorderClients = atoi(argv[i + 1]) != 0;
 				else if (std::string(argv[i]) == "-minimumPopulationSize")
 					config.minimumPopulationSize = atoi(argv[i + 1]);
 				else if (std::string(argv[i]) == "-generationSize")
@@ -145,14 +147,30 @@ public:
 					config.intensificationProbabilityLS = atoi(argv[i + 1]);
 				else if (std::string(argv[i]) == "-diversityWeight")
 					config.diversityWeight = atof(argv[i + 1]);
+				else if (std::string(argv[i]) == "-rejectClones")
+					config.rejectClones = atoi(argv[i + 1]) != 0;
 				else if (std::string(argv[i]) == "-useSwapStarTW")
 					config.useSwapStarTW = atoi(argv[i + 1]) != 0;
 				else if (std::string(argv[i]) == "-skipSwapStarDist")
 					config.skipSwapStarDist = atoi(argv[i + 1]) != 0;
+				else if (std::string(argv[i]) == "-useRouteSegmentTree")
+					config.useRouteSegmentTree = atoi(argv[i + 1]) != 0;
+				else if (std::string(argv[i]) == "-useDontLookBits")
+					config.useDontLookBits = atoi(argv[i + 1]) != 0;
+				else if (std::string(argv[i]) == "-localSearchCacheSize")
+					config.localSearchCacheSize = atoi(argv[i + 1]);
+				else if (std::string(argv[i]) == "-lsThreads")
+					config.nbLocalSearchThreads = atoi(argv[i + 1]);
 				else if (std::string(argv[i]) == "-circleSectorOverlapToleranceDegrees")
 					config.circleSectorOverlapToleranceDegrees = atoi(argv[i + 1]);
 				else if (std::string(argv[i]) == "-minCircleSectorSizeDegrees")
 					config.minCircleSectorSizeDegrees = atoi(argv[i + 1]);
+				else if (std::string(argv[i]) == "-threads")
+					config.nbThreads = atoi(argv[i + 1]);
+				else if (std::string(argv[i]) == "-migrationInterval")
+					config.migrationInterval = atoi(argv[i + 1]);
+				else if (std::string(argv[i]) == "-nbMigrants")
+					config.nbMigrants = atoi(argv[i + 1]);
 				else
 				{
 					// Output error message and help menu to the command line
@@ -181,6 +199,9 @@ public:
 		std::cout << "-------------------------------------------------- HGS-CVRPTW algorithm (2022) -----------------------------------------"	<< std::endl;
 		std::cout << "Call with: ./genvrp instancePath solPath [-it nbIter] [-t myCPUtime] [-bks bksPath] [-seed mySeed] [-veh nbVehicles]    " << std::endl;
 		std::cout << "                                         [-logpool interval]                                                            " << std::endl;
+		std::cout << "Or with: ./genvrp --serve [-socket socketPath] [-maxClients nbClients]                                                  " << std::endl;
+		std::cout << "         to solve the instances received as requests on stdin (or on a UNIX socket) in a persistent process, where      " << std::endl;
+		std::cout << "         memory is allocated upfront for instances with up to nbClients clients (see Server.h)                          " << std::endl;
 		std::cout << std::endl;
 		std::cout << "[-it <int>] sets a maximum number of iterations without improvement. Defaults to 20,000                                 " << std::endl;
 		std::cout << "[-t <int>] sets a time limit in seconds. Defaults to infinity                                                           " << std::endl;
@@ -208,6 +229,8 @@ public:
 		std::cout << "[-useSymmetricCorrelatedVertices <bool>] sets when correlation matrix is symmetric. It can be 0 or 1. Defaults to 0     " << std::endl;
 		std::cout << "[-doRepeatUntilTimeLimit <bool>] sets when to repeat the algorithm when max nr of iter is reached, but time limit is not" << std::endl;
 		std::cout << "                                 reached. It can be 0 or 1. Defaults to 1                                               " << std::endl;
+		std::cout << "[-reorderClients <bool>] renumbers the clients internally along a space filling curve, for better cache locality. The   " << std::endl;
+		std::cout << "                         solution output is not affected. It can be 0 or 1. Defaults to 0                               " << std::endl;
 		std::cout << "[-minimumPopulationSize <int>] sets the minimum population size. Defaults to 25                                         " << std::endl;
 		std::cout << "[-generationSize <int>] sets the number of solutions created before reaching the maximum population size. Defaults to 40" << std::endl;
 		std::cout << "[-nbElite <int>] sets the number of elite individuals. Defaults to 4                                                    " << std::endl;
@@ -227,12 +250,27 @@ public:
 		std::cout << "[-intensificationProbabilityLS <int>] sets the probability intensification moves are performed during LS. Defaults to 15" << std::endl;
 		std::cout << "[-diversityWeight <double>] sets the weight for diversity criterium, if 0, weight is 1-nbElite/populationSize.          " << std::endl;
 		std::cout << "                            Defaults to 0.0                                                                             " << std::endl;
+		std::cout << "[-rejectClones <bool>] sets when to reject clones of individuals in the population, and to skip the local search on     " << std::endl;
+		std::cout << "                       offspring that are clones. It can be 0 or 1. Defaults to 0                                       " << std::endl;
 		std::cout << "[-useSwapStarTW <bool>] sets when to use time windows swap star. It can be 0 or 1. Defaults to 1                        " << std::endl;
 		std::cout << "[-skipSwapStarDist <bool>] sets when to skip normal swap star based on distance. It can be 0 or 1. Defaults to 0        " << std::endl;
+		std::cout << "[-useRouteSegmentTree <bool>] sets when to use a segment tree per route for the time window data of route segments,     " << std::endl;
+		std::cout << "                              instead of seeds every 4 nodes. It can be 0 or 1. Defaults to 0                           " << std::endl;
+		std::cout << "[-useDontLookBits <bool>] sets when to only evaluate the RI moves of clients whose route has been modified since their  " << std::endl;
+		std::cout << "                          moves were last evaluated (faster but less thorough). It can be 0 or 1. Defaults to 0         " << std::endl;
+		std::cout << "[-localSearchCacheSize <int>] sets the maximum number of local search results kept in a cache, such that the local      " << std::endl;
+		std::cout << "                              search is not repeated on the same solution with the same penalties. The least recently used" << std::endl;
+		std::cout << "                              results are evicted. Defaults to 0 (no cache)                                             " << std::endl;
+		std::cout << "[-lsThreads <int>] sets the number of threads to evaluate the SWAP* moves of the route pairs in parallel, and then      " << std::endl;
+		std::cout << "                   apply the non-conflicting improving moves (deterministic). Defaults to 1 (sequential)                " << std::endl;
 		std::cout << "[-circleSectorOverlapToleranceDegrees <int>] sets the margin to take (in degrees 0 - 359) to determine overlap of circle" << std::endl;
 		std::cout << "                                             sectors for SWAP*. Defaults to 0                                           " << std::endl;
 		std::cout << "[-minCircleSectorSizeDegrees <int>] sets the minimum size (in degrees 0 - 359) for circle sectors such that even small  " << std::endl;
 		std::cout << "                                    circle sectors have 'overlap'. Defaults to 15                                       " << std::endl;
+		std::cout << "[-threads <int>] sets the number of islands, each running the genetic algorithm in its own thread. Defaults to 1        " << std::endl;
+		std::cout << "[-migrationInterval <int>] sets the number of iterations between two migrations of elite individuals to the next        " << std::endl;
+		std::cout << "                           island (only used when threads > 1). Defaults to 500                                         " << std::endl;
+		std::cout << "[-nbMigrants <int>] sets the number of elite individuals sent to the next island at every migration. Defaults to 2      " << std::endl;
 		std::cout << "---------------------------------------------------------------------------------------------------------------------------------" << std::endl;
 		std::cout << std::endl;
 	};
@@ -8,6 +8,22 @@
 #include "Params.h"
 #include "Population.h"
 #include "Individual.h"
+#include "IslandModel.h"
+#include "Server.h"
+
+// Exports the best solution found in the population (if any), the search progress and possibly a new BKS
+void exportBestSolution(Population* population, const Params::Config& config)
+{
+	if (population != nullptr && population->getBestFound() != nullptr)
+	{
+		population->getBestFound()->exportCVRPLibFormat(config.pathSolution);
+		population->exportSearchProgress(config.pathSolution + ".PG.csv", config.pathInstance, config.seed);
+		if (config.pathBKS != "")
+		{
+			population->exportBKS(config.pathBKS);
+		}
+	}
+}
 
 // Main class of the algorithm. Used to read from the parameters from the command line,
 // create the structures and initial population, and run the hybrid genetic search
@@ -15,6 +31,14 @@ int main(int argc, char* argv[])
 {
 	try
 	{
+		// Server mode: solve the instances received as requests in a persistent process
+		if (argc >= 2 && std::string(argv[1]) == "--serve")
+		{
+			Server server(argc, argv);
+			server.run();
+			return 0;
+		}
+
 		// Reading the arguments of the program
 		CommandLine commandline(argc, argv);
 
@@ -22,30 +46,42 @@ int main(int argc, char* argv[])
 		std::cout << "----- READING DATA SET FROM: " << commandline.config.pathInstance << std::endl;
 		Params params(commandline);
 
-		// Creating the Split and Local Search structures
-		Split split(&params);
-		LocalSearch localSearch(&params);
-
-		// Initial population
 		std::cout << "----- INSTANCE LOADED WITH " << params.nbClients << " CLIENTS AND " << params.nbVehicles << " VEHICLES" << std::endl;
-		std::cout << "----- BUILDING INITIAL POPULATION" << std::endl;
-		Population population(&params, &split, &localSearch);
-
-		// Genetic algorithm
-		std::cout << "----- STARTING GENETIC ALGORITHM" << std::endl;
-		Genetic solver(&params, &split, &population, &localSearch);
-		solver.run(commandline.config.nbIter, commandline.config.timeLimit);
-		std::cout << "----- GENETIC ALGORITHM FINISHED, TIME SPENT: " << params.getTimeElapsedSeconds() << std::endl;
+		if (params.config.nbThreads > 1)
+		{
+			// Island model: every island builds its own initial population and runs its own genetic algorithm in a separate thread
+			std::cout << "----- STARTING GENETIC ALGORITHM ON " << params.config.nbThreads << " ISLANDS" << std::endl;
+			IslandModel islandModel(&params, params.config.nbThreads);
+			islandModel.run(commandline.config.nbIter, commandline.config.timeLimit);
+			std::cout << "----- GENETIC ALGORITHM FINISHED, TIME SPENT: " << params.getTimeElapsedSeconds() << std::endl;
 
-		// Export the best solution, if it exist
-		if (population.getBestFound() != nullptr)
+			// Export the best solution over all islands, if it exist
+			exportBestSolution(islandModel.getBestPopulation(), commandline.config);
+#ifdef LS_STATISTICS
+			islandModel.getLocalSearchStatistics().exportCSV(commandline.config.pathSolution + ".LS.csv");
+#endif
+		}
+		else
 		{
-			population.getBestFound()->exportCVRPLibFormat(commandline.config.pathSolution);
-			population.exportSearchProgress(commandline.config.pathSolution + ".PG.csv", commandline.config.pathInstance, commandline.config.seed);
-			if (commandline.config.pathBKS != "")
-			{
-				population.exportBKS(commandline.config.pathBKS);
-			}
+			// Creating the Split and Local Search structures
+			Split split(&params);
+			LocalSearch localSearch(&params);
+
+			// Initial population
+			std::cout << "----- BUILDING INITIAL POPULATION" << std::endl;
+			Population population(&params, &split, &localSearch);
+
+			// Genetic algorithm
+			std::cout << "----- STARTING GENETIC ALGORITHM" << std::endl;
+			Genetic solver(&params, &split, &population, &localSearch);
+			solver.run(commandline.config.nbIter, commandline.config.timeLimit);
+			std::cout << "----- GENETIC ALGORITHM FINISHED, TIME SPENT: " << params.getTimeElapsedSeconds() << std::endl;
+
+			// Export the best solution, if it exist
+			exportBestSolution(&population, commandline.config);
+#ifdef LS_STATISTICS
+			localSearch.getStatistics().exportCSV(commandline.config.pathSolution + ".LS.csv");
+#endif
 		}
 	}
 
@@ -3,6 +3,8 @@ import argparse
 import subprocess
 import sys
 import os
+import io
+import struct
 import uuid
 import platform
 import numpy as np
@@ -12,7 +14,7 @@ import tools
 from environment import VRPEnvironment, ControllerEnvironment
 from baselines.strategies import STRATEGIES
 
-def solve_static_vrptw(instance, time_limit=3600, tmp_dir="tmp", seed=1, initial_solution=None):
+def solve_static_vrptw(instance, time_limit=3600, tmp_dir="tmp", seed=1, initial_solution=None, server=None):
 
     # Prevent passing empty instances to the static solver, e.g. when
     # strategy decides to not dispatch any requests for the current epoch
@@ -26,15 +28,15 @@ def solve_static_vrptw(instance, time_limit=3600, tmp_dir="tmp", seed=1, initial
         yield solution, cost
         return
 
+    if server is not None:
+        yield from server.solve(instance, time_limit=time_limit, seed=seed, initial_solution=initial_solution)
+        return
+
     os.makedirs(tmp_dir, exist_ok=True)
     instance_filename = os.path.join(tmp_dir, "problem.vrptw")
     tools.write_vrplib(instance_filename, instance, is_vrptw=True)
 
-    executable = os.path.join('baselines', 'hgs_vrptw', 'genvrp')
-    # On windows, we may have genvrp.exe
-    if platform.system() == 'Windows' and os.path.isfile(executable + '.exe'):
-        executable = executable + '.exe'
-    assert os.path.isfile(executable), f"HGS executable {executable} does not exist!"
+    executable = get_hgs_executable()
     # Call HGS solver with unlimited number of vehicles allowed and parse outputs
     # Subtract two seconds from the time limit to account for writing of the instance and delay in enforcing the time limit by HGS
 
@@ -47,27 +49,74 @@ def solve_static_vrptw(instance, time_limit=3600, tmp_dir="tmp", seed=1, initial
     if initial_solution is not None:
         hgs_cmd += ['-initialSolution', " ".join(map(str, tools.to_giant_tour(initial_solution)))]
     with subprocess.Popen(hgs_cmd, stdout=subprocess.PIPE, text=True) as p:
-        routes = []
-        for line in p.stdout:
-            line = line.strip()
-            # Parse only lines which contain a route
-            if line.startswith('Route'):
-                label, route = line.split(": ")
-                route_nr = int(label.split("#")[-1])
-                assert route_nr == len(routes) + 1, "Route number should be strictly increasing"
-                routes.append([int(node) for node in route.split(" ")])
-            elif line.startswith('Cost'):
-                # End of solution
-                solution = routes
-                cost = int(line.split(" ")[-1].strip())
-                check_cost = tools.validate_static_solution(instance, solution)
-                assert cost == check_cost, "Cost of HGS VRPTW solution could not be validated"
-                yield solution, cost
-                # Start next solution
-                routes = []
-            elif "EXCEPTION" in line:
-                raise Exception("HGS failed with exception: " + line)
-        assert len(routes) == 0, "HGS has terminated with imcomplete solution (is the line with Cost missing?)"
+        yield from parse_hgs_output(p.stdout, instance)
+
+
+def get_hgs_executable():
+    executable = os.path.join('baselines', 'hgs_vrptw', 'genvrp')
+    # On windows, we may have genvrp.exe
+    if platform.system() == 'Windows' and os.path.isfile(executable + '.exe'):
+        executable = executable + '.exe'
+    assert os.path.isfile(executable), f"HGS executable {executable} does not exist!"
+    return executable
+
+
+def parse_hgs_output(lines, instance):
+    # Yields all solutions printed by HGS, until the end of the output or the end of a server response
+    routes = []
+    for line in lines:
+        line = line.strip()
+        # Parse only lines which contain a route
+        if line.startswith('Route'):
+            label, route = line.split(": ")
+            route_nr = int(label.split("#")[-1])
+            assert route_nr == len(routes) + 1, "Route number should be strictly increasing"
+            routes.append([int(node) for node in route.split(" ")])
+        elif line.startswith('Cost'):
+            # End of solution
+            solution = routes
+            cost = int(line.split(" ")[-1].strip())
+            check_cost = tools.validate_static_solution(instance, solution)
+            assert cost == check_cost, "Cost of HGS VRPTW solution could not be validated"
+            yield solution, cost
+            # Start next solution
+            routes = []
+        elif "EXCEPTION" in line:
+            raise Exception("HGS failed with exception: " + line)
+        elif line == HgsServer.END_OF_RESPONSE:
+            break
+    assert len(routes) == 0, "HGS has terminated with imcomplete solution (is the line with Cost missing?)"
+
+
+class HgsServer:
+    # Keeps a single HGS process (genvrp --serve) running to solve the instances of all epochs, which avoids
+    # starting a process, writing the instance to disk and allocating the data structures of HGS for every epoch
+    END_OF_RESPONSE = "----- REQUEST FINISHED"
+
+    def __init__(self, max_clients=0):
+        self.process = subprocess.Popen(
+            [get_hgs_executable(), '--serve', '-maxClients', str(max_clients)],
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE
+        )
+        self.stdout = io.TextIOWrapper(self.process.stdout)
+
+    def solve(self, instance, time_limit=3600, seed=1, initial_solution=None):
+        # Request: the command line arguments (one per line), an empty line and the instance, preceded by the length (uint32 little endian)
+        # Only subtract one second from the time limit since the instance is not written to disk
+        arguments = ['-t', str(max(time_limit - 1, 1)), '-seed', str(seed), '-veh', '-1', '-useWallClockTime', '1']
+        if initial_solution is None:
+            initial_solution = [[i] for i in range(1, instance['coords'].shape[0])]
+        arguments += ['-initialSolution', " ".join(map(str, tools.to_giant_tour(initial_solution)))]
+        f = io.StringIO()
+        tools.write_vrplib(f, instance, is_vrptw=True)
+        message = ("\n".join(arguments) + "\n\n" + f.getvalue()).encode()
+        self.process.stdin.write(struct.pack('<I', len(message)) + message)
+        self.process.stdin.flush()
+        yield from parse_hgs_output(self.stdout, instance)
+
+    def close(self):
+        self.process.stdin.close()
+        self.process.wait()
 
 
 def run_oracle(args, env):
@@ -96,7 +145,7 @@ def run_oracle(args, env):
     return total_reward
 
 
-def run_baseline(args, env, oracle_solution=None, strategy=None, seed=None):
+def run_baseline(args, env, oracle_solution=None, strategy=None, seed=None, server=None):
 
     strategy = strategy or args.strategy
     strategy = STRATEGIES[strategy] if isinstance(strategy, str) else strategy
@@ -131,7 +180,7 @@ def run_baseline(args, env, oracle_solution=None, strategy=None, seed=None):
             # Run HGS with time limit and get last solution (= best solution found)
             # Note we use the same solver_seed in each epoch: this is sufficient as for the static problem
             # we will exactly use the solver_seed whereas in the dynamic problem randomness is in the instance
-            solutions = list(solve_static_vrptw(epoch_instance_dispatch, time_limit=epoch_tlim, tmp_dir=args.tmp_dir, seed=args.solver_seed))
+            solutions = list(solve_static_vrptw(epoch_instance_dispatch, time_limit=epoch_tlim, tmp_dir=args.tmp_dir, seed=args.solver_seed, server=server))
             assert len(solutions) > 0, f"No solution found during epoch {observation['current_epoch']}"
             epoch_solution, cost = solutions[-1]
 
@@ -180,6 +229,7 @@ if __name__ == "__main__":
     parser.add_argument("--tmp_dir", type=str, default=None, help="Provide a specific directory to use as tmp directory (useful for debugging)")
     parser.add_argument("--model_path", type=str, default=None, help="Provide the path of the machine learning model to be used as strategy (Path must not contain `model.pth`)")
     parser.add_argument("--verbose", action='store_true', help="Show verbose output")
+    parser.add_argument("--hgs_server", action='store_true', help="Keep a single HGS process running to solve all epochs (instead of one process per epoch)")
     args = parser.parse_args()
 
     if args.tmp_dir is None:
@@ -190,7 +240,11 @@ if __name__ == "__main__":
         # If tmp dir is manually provided, don't clean it up (for debugging)
         cleanup_tmp_dir = False
 
+    server = None
     try:
+        if args.hgs_server:
+            server = HgsServer()
+
         if args.instance is not None:
             env = VRPEnvironment(seed=args.instance_seed, instance=tools.read_vrplib(args.instance), epoch_tlim=args.epoch_tlim, is_static=args.static)
         else:
@@ -218,10 +272,12 @@ if __name__ == "__main__":
             else:
                 strategy = STRATEGIES[args.strategy]
 
-            run_baseline(args, env, strategy=strategy)
+            run_baseline(args, env, strategy=strategy, server=server)
 
         if args.instance is not None:
             log(tools.json_dumps_np(env.final_solutions))
     finally:
+        if server is not None:
+            server.close()
         if cleanup_tmp_dir:
             tools.cleanup_tmp_dir(args.tmp_dir)
@@ -1,5 +1,7 @@
+import contextlib
 import json
 import os
+import struct
 import numpy as np
 
 # https://stackoverflow.com/questions/26646362/numpy-array-is-not-json-serializable
@@ -258,7 +260,8 @@ def write_vrplib(filename, instance, name="problem", euclidean=False, is_vrptw=T
     assert (np.diag(duration_matrix) == 0).all()
     assert (demands[~is_depot] > 0).all()
         
-    with open(filename, 'w') as f:
+    # filename can also be a file object (e.g. io.StringIO to send the instance to the HGS server)
+    with (open(filename, 'w') if isinstance(filename, str) else contextlib.nullcontext(filename)) as f:
         f.write("\n".join([
             "{} : {}".format(k, v)
             for k, v in [
@@ -328,4 +331,44 @@ def write_vrplib(filename, instance, name="problem", euclidean=False, is_vrptw=T
                 ]))
                 f.write("\n")
             
-        f.write("EOF\n")
\ No newline at end of file
+        f.write("EOF\n")
+
+def write_binary_instance(filename, instance, name="problem"):
+    # Binary instance format of HGS (see baselines/hgs_vrptw/InstanceData.h), which HGS memory maps instead of parsing the duration matrix
+    coords = instance['coords']
+    n = len(coords)
+    duration_matrix = np.ascontiguousarray(instance['duration_matrix'], dtype='<i4')
+    assert duration_matrix.shape == (n, n)
+    assert (np.diag(duration_matrix) == 0).all()
+    assert (instance['demands'][~instance['is_depot']] > 0).all()
+
+    is_vrptw = instance.get('time_windows') is not None and len(instance['time_windows']) == n
+    time_windows = instance['time_windows'] if is_vrptw else np.zeros((n, 2), dtype=int)
+    service_times = instance.get('service_times')
+    if service_times is None or len(service_times) != n:
+        service_times = np.zeros(n, dtype=int)
+    release_times = instance.get('release_times', np.zeros(n, dtype=int))
+
+    header = struct.pack(
+        '<8s6i96s', b'HGSVRPB1', n, instance['capacity'], 0, 0, 1 if is_vrptw else 0, duration_matrix.max(), name.encode()[:96]
+    )
+    client_arrays = np.stack([
+        coords[:, 0], coords[:, 1], instance['demands'], service_times, time_windows[:, 0], time_windows[:, 1], release_times
+    ]).astype('<i4')
+    with open(filename, 'wb') as f:
+        f.write(header)
+        f.write(duration_matrix.tobytes())
+        f.write(client_arrays.tobytes())
+
+
+def convert_vrplib_to_binary(vrplib_filename, binary_filename):
+    name = os.path.splitext(os.path.basename(vrplib_filename))[0]
+    write_binary_instance(binary_filename, read_vrplib(vrplib_filename), name=name)
+
+
+if __name__ == "__main__":
+    # Converts instances to the binary format of HGS: python tools.py instance.txt [instance2.txt ...]
+    # The binary instance is written next to the original instance, with extension .bin
+    import sys
+    for vrplib_filename in sys.argv[1:]:
+        convert_vrplib_to_binary(vrplib_filename, os.path.splitext(vrplib_filename)[0] + '.bin')